@@ -16,6 +16,7 @@
 #include "PlayerAgent.hpp"
 #include "RandomAgent.hpp"
 #include "SingleActionAgent.hpp"
+#include "SearchAgent.hpp"
 #include "game_controller.h"
 
 /* **********************************************************************
@@ -151,6 +152,8 @@ PlayerAgent* PlayerAgent::generate_agent_instance(OSystem* _osystem,
       new_agent = new RandomAgent(_osystem, _settings);
     else if (player_agent == "single_action_agent")
       new_agent = new SingleActionAgent(_osystem, _settings);
+    else if (player_agent == "uct")
+      new_agent = new SearchAgent(_osystem, _settings);
     else
       new_agent = NULL;
 
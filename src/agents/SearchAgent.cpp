@@ -0,0 +1,260 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  SearchAgent.cpp
+ *
+ * The implementation of the SearchAgent class.
+ **************************************************************************** */
+
+#include <cmath>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include "SearchAgent.hpp"
+#include "../ale_interface.hpp"
+#include "../control/ALEStatePool.hpp"
+#include "misc_tools.h"
+
+SearchAgent::SearchAgent(OSystem* _osystem, RomSettings* _settings) :
+    PlayerAgent(_osystem, _settings),
+    i_repeats_left(0),
+    i_searches(0), l_nodes(0), l_search_millis(0), d_node_bytes(0) {
+  Settings& settings = p_osystem->settings();
+
+  i_simulations = std::max(settings.getInt("uct_simulations", true), 1);
+  i_max_depth = std::max(settings.getInt("uct_depth", true), 1);
+  i_num_threads = std::max(settings.getInt("uct_threads", true), 1);
+  i_frame_skip = std::max(settings.getInt("uct_frame_skip", true), 0);
+  f_exploration = settings.getFloat("uct_exploration", true);
+}
+
+SearchAgent::~SearchAgent() {
+  for (size_t t = 0; t < v_trees.size(); t++) {
+    delete v_trees[t]->pool;
+    delete v_trees[t]->env;
+    delete v_trees[t];
+  }
+}
+
+/* *********************************************************************
+    The search emulators are created one after the other, as console
+    creation is not thread-safe. They run the same ROM, with no agent and
+    no observations.
+ ******************************************************************** */
+void SearchAgent::createTrees() {
+  Settings& settings = p_osystem->settings();
+  ALEConfig config;
+  config.random_seed = settings.getString("random_seed") == "time" ? -1 :
+    settings.getInt("random_seed");
+  config.system_reset_steps = settings.getInt("system_reset_steps");
+  config.max_num_frames = 0;
+  config.observation_mode = OBSERVE_NONE;
+
+  // loadROM seeds the global generator again; the agent's draws carry on
+  // from a value taken before, rather than restart from the seed
+  unsigned resume_seed = rand();
+
+  int simulations_per_thread = (i_simulations + i_num_threads - 1) / i_num_threads;
+  for (int t = 0; t < i_num_threads; t++) {
+    UCTTree* tree = new UCTTree();
+    tree->env = new ALEInterface();
+    if (!tree->env->loadROM(p_osystem->romFile(), config)) {
+      cerr << "Unable to create the search emulators" << endl;
+      exit(-1);
+    }
+    // One slab holds a whole tree
+    tree->pool = new ALEStatePool(tree->env->game_controller->getState(),
+                                  simulations_per_thread + 1);
+    // Every tree draws its own sequence of rollout actions
+    tree->random_state = (uInt32)tree->env->random_seed + t;
+    v_trees.push_back(tree);
+  }
+  srand(resume_seed);
+}
+
+Action SearchAgent::act() {
+  // A decision lasts 1 + frame_skip frames
+  if (i_repeats_left > 0) {
+    i_repeats_left--;
+    return m_current_action;
+  }
+  if (p_rom_settings->isTerminal())
+    return available_actions[0];
+
+  if (v_trees.empty()) createTrees();
+
+  // Every tree starts from the current state
+  ALEState root(*p_osystem->getGameController()->getState());
+  root.save();
+  for (size_t t = 0; t < v_trees.size(); t++) {
+    ALEState* state = v_trees[t]->env->game_controller->getState();
+    state->copySaved(root);
+    state->load();
+  }
+
+  long start = timeMillis();
+  int simulations_per_thread = (i_simulations + i_num_threads - 1) / i_num_threads;
+  if (v_trees.size() == 1)
+    search(v_trees[0], simulations_per_thread);
+  else {
+    boost::thread_group threads;
+    for (size_t t = 0; t < v_trees.size(); t++)
+      threads.create_thread(boost::bind(&SearchAgent::search, this, v_trees[t],
+                                        simulations_per_thread));
+    threads.join_all();
+  }
+  l_search_millis += timeMillis() - start;
+  i_searches++;
+
+  // Sum the root statistics over the trees
+  int num_actions = available_actions.size();
+  std::vector<int> visits(num_actions, 0);
+  std::vector<double> values(num_actions, 0);
+  for (size_t t = 0; t < v_trees.size(); t++) {
+    UCTTree* tree = v_trees[t];
+    const UCTNode& node = tree->nodes[0];
+    for (int a = 0; a < node.num_expanded; a++) {
+      visits[a] += tree->nodes[node.first_child + a].visits;
+      values[a] += tree->nodes[node.first_child + a].value_sum;
+    }
+
+    l_nodes += tree->pool->numAllocated();
+    d_node_bytes += tree->pool->memoryUsed() + tree->nodes.capacity() * sizeof(UCTNode);
+  }
+
+  // The most visited action; ties go to the better mean return
+  int best = 0;
+  for (int a = 1; a < num_actions; a++) {
+    if (visits[a] > visits[best] ||
+        (visits[a] == visits[best] && visits[a] > 0 &&
+         values[a] / visits[a] > values[best] / visits[best]))
+      best = a;
+  }
+
+  m_current_action = available_actions[best];
+  i_repeats_left = i_frame_skip;
+  return m_current_action;
+}
+
+void SearchAgent::search(UCTTree* tree, int num_simulations) {
+  // The nodes and states of the previous search are dropped at once
+  tree->nodes.clear();
+  tree->pool->releaseAll();
+  tree->return_scale = 1;
+
+  UCTNode root = {tree->pool->save(), 0, 0, 0, -1, 0, false};
+  tree->nodes.push_back(root);
+
+  for (int i = 0; i < num_simulations; i++)
+    simulate(tree);
+}
+
+void SearchAgent::simulate(UCTTree* tree) {
+  // References to nodes are not kept: adding children moves them
+  std::vector<UCTNode>& nodes = tree->nodes;
+  int num_actions = available_actions.size();
+
+  // Selection, down to a node with an action not tried yet
+  tree->path.clear();
+  tree->path.push_back(0);
+  int n = 0, depth = 0;
+  bool expanded = false;
+  while (!nodes[n].terminal && depth < i_max_depth) {
+    if (nodes[n].first_child < 0) {
+      nodes[n].first_child = nodes.size();
+      UCTNode child = {NULL, 0, 0, 0, -1, 0, false};
+      nodes.insert(nodes.end(), num_actions, child);
+    }
+    depth++;
+
+    // Expansion
+    if (nodes[n].num_expanded < num_actions) {
+      int a = nodes[n].num_expanded++;
+      int c = nodes[n].first_child + a;
+      tree->pool->load(nodes[n].state);
+      bool terminal;
+      nodes[c].reward = step(tree, available_actions[a], terminal);
+      nodes[c].terminal = terminal;
+      nodes[c].state = tree->pool->save();
+      tree->path.push_back(c);
+      n = c;
+      expanded = true;
+      break;
+    }
+
+    n = selectChild(tree, n);
+    tree->path.push_back(n);
+  }
+
+  // Random playout from the new node, which the emulator is in
+  double value = 0;
+  bool terminal = nodes[n].terminal;
+  while (expanded && !terminal && depth < i_max_depth) {
+    tree->random_state = tree->random_state * 1103515245u + 12345u;
+    value += step(tree, available_actions[(tree->random_state >> 16) % num_actions], terminal);
+    depth++;
+  }
+
+  // Backup
+  for (int i = tree->path.size() - 1; i >= 0; i--) {
+    UCTNode& node = nodes[tree->path[i]];
+    value += node.reward;
+    node.visits++;
+    node.value_sum += value;
+  }
+  tree->return_scale = std::max(tree->return_scale, fabs(value));
+}
+
+float SearchAgent::step(UCTTree* tree, Action action, bool& terminal) {
+  ALEState* state = tree->env->game_controller->getState();
+  RomSettings* settings = state->getSettings();
+
+  float reward = 0;
+  terminal = false;
+  for (int f = 0; f <= i_frame_skip && !terminal; f++) {
+    state->apply_action(action, PLAYER_B_NOOP);
+    state->simulate();
+    reward += settings->getReward();
+    terminal = settings->isTerminal();
+  }
+  return reward;
+}
+
+int SearchAgent::selectChild(UCTTree* tree, int n) {
+  const UCTNode& parent = tree->nodes[n];
+  double log_visits = log((double)parent.visits);
+
+  int best = -1;
+  double best_score = 0;
+  for (int a = 0; a < parent.num_expanded; a++) {
+    const UCTNode& child = tree->nodes[parent.first_child + a];
+    double score = child.value_sum / child.visits / tree->return_scale +
+      f_exploration * sqrt(log_visits / child.visits);
+    if (best < 0 || score > best_score) {
+      best = parent.first_child + a;
+      best_score = score;
+    }
+  }
+  return best;
+}
+
+void SearchAgent::episode_end(void) {
+  if (i_searches > 0) {
+    cout << "UCT: " << i_searches << " searches, "
+         << (long)(l_nodes * 1000.0 / std::max(l_search_millis, 1L)) << " nodes/sec, "
+         << (long)(d_node_bytes / std::max(l_nodes, 1L)) << " bytes/node" << endl;
+  }
+  i_searches = 0;
+  l_nodes = 0;
+  l_search_millis = 0;
+  d_node_bytes = 0;
+  i_repeats_left = 0;
+
+  PlayerAgent::episode_end();
+}
@@ -0,0 +1,105 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  SearchAgent.hpp
+ *
+ * The implementation of the SearchAgent class, which plays by UCT search
+ *  ('player_agent=uct'). Before every decision each search thread builds its
+ *  own tree from the current state in its own emulator (root parallelism),
+ *  and the visit counts of the root actions are summed over the trees. Node
+ *  states are kept in an ALEStatePool, released at once after each search.
+ *
+ *  Settings: uct_simulations (per decision, over all threads), uct_depth (in
+ *  decisions), uct_threads, uct_frame_skip (extra frames each decision lasts)
+ *  and uct_exploration (the UCB constant, for returns scaled to [-1, 1]).
+ **************************************************************************** */
+
+#ifndef __SEARCH_AGENT_HPP__
+#define __SEARCH_AGENT_HPP__
+
+#include <vector>
+#include "../common/Constants.h"
+#include "PlayerAgent.hpp"
+#include "../emucore/OSystem.hxx"
+
+class ALEInterface;
+class ALEStatePool;
+struct ALEStateSlot;
+
+class SearchAgent : public PlayerAgent {
+    public:
+        SearchAgent(OSystem * _osystem, RomSettings * _settings);
+        virtual ~SearchAgent();
+
+        /* *********************************************************************
+            Reports the search speed and memory use of the episode
+         ******************************************************************** */
+        virtual void episode_end(void);
+
+	protected:
+        /* *********************************************************************
+            Returns the best action from the set of possible actions
+         ******************************************************************** */
+        virtual Action act();
+
+        struct UCTNode {
+            ALEStateSlot* state;     // State reached; NULL until expanded
+            float reward;            // Reward received on the way to it
+            double value_sum;        // Sum of the returns through it
+            int visits;
+            int first_child;         // Index of its children, one per action
+            int num_expanded;        // Children expanded so far, in order
+            bool terminal;
+        };
+
+        /* One search thread: an emulator and the tree it builds */
+        struct UCTTree {
+            ALEInterface* env;
+            ALEStatePool* pool;
+            std::vector<UCTNode> nodes;   // nodes[0] is the root
+            std::vector<int> path;
+            double return_scale;          // Largest absolute return seen
+            uInt32 random_state;
+        };
+
+        /* Creates the search threads' emulators, on the first decision */
+        void createTrees();
+
+        /* Runs the given number of simulations from the state last saved in
+           the tree's emulator */
+        void search(UCTTree* tree, int num_simulations);
+        void simulate(UCTTree* tree);
+
+        /* Plays an action for 1 + frame_skip frames from the emulator's current
+           state; returns the reward */
+        float step(UCTTree* tree, Action action, bool& terminal);
+
+        int selectChild(UCTTree* tree, int node);
+
+    protected:
+        int i_simulations;
+        int i_max_depth;
+        int i_num_threads;
+        int i_frame_skip;
+        float f_exploration;
+
+        std::vector<UCTTree*> v_trees;
+
+        Action m_current_action;
+        int i_repeats_left;           // Frames left in the current decision
+
+        // Statistics over the episode
+        int i_searches;
+        long l_nodes;
+        long l_search_millis;
+        double d_node_bytes;          // Memory held by the trees, summed over searches
+};
+
+#endif // __SEARCH_AGENT_HPP__
@@ -3,6 +3,7 @@ MODULE := src/agents
 MODULE_OBJS := \
 	src/agents/PlayerAgent.o \
 	src/agents/RandomAgent.o \
+	src/agents/SearchAgent.o \
 	src/agents/SingleActionAgent.o \
 
 MODULE_DIRS += \
@@ -0,0 +1,231 @@
+#ifndef ALE_ASYNC_H
+#define ALE_ASYNC_H
+
+#include <deque>
+#include <boost/thread.hpp>
+#include <boost/shared_ptr.hpp>
+#include "ale_interface.hpp"
+
+class ALEAsyncEnvironment;
+
+/**
+   Shared state of one asynchronous step.
+ */
+struct ALEStepState {
+    boost::mutex mutex;
+    boost::condition_variable finished;
+    bool done;
+    float reward;
+    bool game_over;
+
+    ALEStepState(): done(false), reward(0), game_over(false) {}
+};
+
+/**
+   Handle to the result of an asynchronous step. Copies refer to the same step.
+ */
+class ALEStepFuture
+{
+public:
+    ALEStepFuture() {}
+    explicit ALEStepFuture(const boost::shared_ptr<ALEStepState>& state): state(state) {}
+
+    // Whether this handle refers to a step at all
+    bool valid() const { return state.get() != NULL; }
+
+    // Whether the step has completed; never blocks. False for a handle
+    // which refers to no step.
+    bool ready() const {
+        if (!valid()) return false;
+        boost::mutex::scoped_lock lock(state->mutex);
+        return state->done;
+    }
+
+    // Blocks until the step has completed; the handle must be valid
+    void wait() const {
+        assert(valid());
+        boost::mutex::scoped_lock lock(state->mutex);
+        while (!state->done)
+            state->finished.wait(lock);
+    }
+
+    // Blocks until the step has completed and returns its reward
+    float get() const {
+        wait();
+        return state->reward;
+    }
+
+    // Whether the game was over after the step; blocks like get()
+    bool game_over() const {
+        wait();
+        return state->game_over;
+    }
+
+private:
+    boost::shared_ptr<ALEStepState> state;
+};
+
+/**
+   A completed step, as delivered through an ALECompletionQueue.
+ */
+struct ALECompletion {
+    ALEAsyncEnvironment* env;    // Environment which took the step
+    int tag;                     // Tag given to actAsync
+    float reward;
+    bool game_over;
+};
+
+/**
+   Collects the completions of steps issued to any number of environments,
+   so that a single-threaded event loop can poll for whichever finishes first.
+ */
+class ALECompletionQueue
+{
+public:
+    // Takes the oldest completion, if there is one; never blocks
+    bool poll(ALECompletion& completion) {
+        boost::mutex::scoped_lock lock(mutex);
+        if (completions.empty())
+            return false;
+        completion = completions.front();
+        completions.pop_front();
+        return true;
+    }
+
+    // Blocks until a completion is available and takes it
+    void wait(ALECompletion& completion) {
+        boost::mutex::scoped_lock lock(mutex);
+        while (completions.empty())
+            available.wait(lock);
+        completion = completions.front();
+        completions.pop_front();
+    }
+
+    // Called by the environments' workers
+    void push(const ALECompletion& completion) {
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            completions.push_back(completion);
+        }
+        available.notify_one();
+    }
+
+private:
+    boost::mutex mutex;
+    boost::condition_variable available;
+    std::deque<ALECompletion> completions;
+};
+
+/**
+   Runs an ALEInterface on its own worker thread. Steps are queued and taken
+   in order; each returns a future, and can also be reported to a completion
+   queue. The screen/RAM copies, display and visual processing done by act()
+   all happen on the worker.
+
+   While steps are pending the ALEInterface (screen_matrix, ram_content, ...)
+   must not be touched; wait for the last future or completion first.
+ */
+class ALEAsyncEnvironment
+{
+public:
+    // The interface must already have a ROM loaded; it is not owned
+    ALEAsyncEnvironment(ALEInterface* ale): ale(ale), stopping(false) {
+        worker = boost::thread(boost::bind(&ALEAsyncEnvironment::run, this));
+    }
+
+    // Finishes the pending steps, then stops the worker
+    ~ALEAsyncEnvironment() {
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            stopping = true;
+        }
+        pending.notify_one();
+        worker.join();
+    }
+
+    ALEInterface& interface() { return *ale; }
+
+    // Queues a step with the given action
+    ALEStepFuture actAsync(Action action, ALECompletionQueue* queue = NULL, int tag = 0) {
+        return issue(action, false, queue, tag);
+    }
+
+    // Queues a reset of the game; it completes with a reward of 0
+    ALEStepFuture resetAsync(ALECompletionQueue* queue = NULL, int tag = 0) {
+        return issue(PLAYER_A_NOOP, true, queue, tag);
+    }
+
+protected:
+    struct Request {
+        Action action;
+        bool reset;
+        boost::shared_ptr<ALEStepState> state;
+        ALECompletionQueue* queue;
+        int tag;
+    };
+
+    ALEStepFuture issue(Action action, bool reset, ALECompletionQueue* queue, int tag) {
+        Request request;
+        request.action = action;
+        request.reset = reset;
+        request.state.reset(new ALEStepState());
+        request.queue = queue;
+        request.tag = tag;
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            requests.push_back(request);
+        }
+        pending.notify_one();
+        return ALEStepFuture(request.state);
+    }
+
+    void run() {
+        for (;;) {
+            Request request;
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                while (requests.empty() && !stopping)
+                    pending.wait(lock);
+                if (requests.empty())
+                    return;
+                request = requests.front();
+                requests.pop_front();
+            }
+
+            float reward = 0;
+            if (request.reset)
+                ale->reset_game();
+            else
+                reward = ale->act(request.action);
+            bool game_over = ale->game_over();
+
+            {
+                ALEStepState& state = *request.state;
+                boost::mutex::scoped_lock lock(state.mutex);
+                state.reward = reward;
+                state.game_over = game_over;
+                state.done = true;
+            }
+            request.state->finished.notify_all();
+
+            if (request.queue != NULL) {
+                ALECompletion completion;
+                completion.env = this;
+                completion.tag = request.tag;
+                completion.reward = reward;
+                completion.game_over = game_over;
+                request.queue->push(completion);
+            }
+        }
+    }
+
+protected:
+    ALEInterface* ale;
+    boost::thread worker;
+    boost::mutex mutex;
+    boost::condition_variable pending;
+    std::deque<Request> requests;
+    bool stopping;
+};
+
+#endif
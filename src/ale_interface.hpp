@@ -3,9 +3,12 @@
 
 #include <cstdlib>
 #include <ctime>
+#include <zlib.h>
 #include "emucore/m6502/src/bspf/src/bspf.hxx"
 #include "emucore/Console.hxx"
 #include "emucore/Event.hxx"
+#include "emucore/EnvArena.hxx"
+#include "emucore/M6532.hxx"
 #include "emucore/PropsSet.hxx"
 #include "emucore/Settings.hxx"
 #include "emucore/FSNode.hxx"
@@ -16,7 +19,13 @@
 #include "control/internal_controller.h"
 #include "common/Constants.h"
 #include "common/Defaults.hpp"
+#include "common/ALEConfig.hpp"
 #include "common/visual_processor.h"
+#include "common/screen_preprocessor.h"
+#include "common/screen_exporter.h"
+#include "common/action_trace.h"
+#include "common/state_blob.h"
+#include "common/export_screen.h"
 #include "games/RomSettings.hpp"
 #include "games/Roms.hpp"
 #include "agents/PlayerAgent.hpp"
@@ -37,6 +46,15 @@ static std::string welcomeMessage() {
     return oss.str();
 }
 
+// The state of an environment kept in memory, e.g. to copy it into another
+// environment of the same ROM; saveSnapshot serializes the same fields
+struct ALESnapshot {
+    string emulator;             // The emulator, as saved by ALEState
+    string rom_state;            // The RomSettings of the interface
+    vector<uInt8> screen;        // The current screen; empty if not taken
+    int frame;
+    float game_score;
+};
 
 /**
    This class interfaces ALE with external code for controlling agents.
@@ -45,116 +63,142 @@ class ALEInterface
 {
 public:
     OSystem* theOSystem;
+    Settings* theSettings;
     InternalController* game_controller;
     MediaSource *mediasrc;
     System* emulator_system;
     RomSettings* game_settings;
     VisualProcessor* visProc;
+    ScreenPreprocessor* preprocessor; // Only set once setPreprocessing is called
+    ObservationHistory* screen_history; // Only set once setObservationHistory is called
+    ScreenExporter* exporter;    // Only set once a screen or video is exported
+    string video_prefix;         // Episodes are recorded to video_prefix_<n>.png
+    ExportVideo* episode_video;  // Video of the current episode, if recording
+    int video_episode;           // Number of the current episode's video
+    ActionTraceWriter* action_trace; // Only set while recording an action trace
+    EnvArena* arena;             // Holds the emulator objects, if loadROM was given an arena_size
 
     int screen_width, screen_height;  // Dimensions of the screen
     IntMatrix screen_matrix;     // This contains the raw pixel representation of the screen
     IntVect ram_content;         // This contains the ram content of the Atari
+    vector<uInt8> rows_changed;  // Screen rows changed since screen_matrix was last copied
 
     int frame;                   // Current frame number
     int max_num_frames;          // Maximum number of frames allowed in this episode
+    int frame_skip;              // Extra frames each action is repeated for
+    int random_seed;             // Seed given to srand by loadROM
     float game_score;            // Score accumulated throughout the course of a game
     ActionVect allowed_actions;  // Vector of allowed actions for this game
     Action last_action;          // Always stores the latest action taken
     time_t time_start, time_end; // Used to keep track of fps
     bool display_active;         // Should the screen be displayed or not
     bool process_screen;         // Should visual processing be performed or not
+    ObservationMode observation_mode; // What act() copies out of the emulator
 
 public:
-    ALEInterface(): theOSystem(NULL), game_controller(NULL), mediasrc(NULL), emulator_system(NULL),
-                    game_settings(NULL), frame(0), max_num_frames(-1),
-                    game_score(0), display_active(false) {
+    ALEInterface(): theOSystem(NULL), theSettings(NULL), game_controller(NULL), mediasrc(NULL),
+                    emulator_system(NULL), game_settings(NULL), preprocessor(NULL), screen_history(NULL),
+                    exporter(NULL), episode_video(NULL), video_episode(0), action_trace(NULL),
+                    arena(NULL), frame(0), max_num_frames(-1),
+                    frame_skip(0), game_score(0), display_active(false),
+                    observation_mode(OBSERVE_SCREEN_AND_RAM) {
     }
 
     ~ALEInterface() {
-        if (theOSystem) delete theOSystem;
+        // Finishes the queued screens and the current episode's video
+        if (exporter) delete exporter;
+        if (action_trace) delete action_trace;
+        if (preprocessor) delete preprocessor;
+        if (screen_history) delete screen_history;
+        if (game_settings) delete game_settings;
         if (game_controller) delete game_controller;
+        if (theOSystem) delete theOSystem;
+        if (theSettings) delete theSettings;
+        if (arena) delete arena;
     }
 
     // Loads and initializes a game. After this call the game should be ready to play.
     bool loadROM(string rom_file, bool display_screen, bool process_screen) {
-        display_active = display_screen;
-        this->process_screen = process_screen;
-        int argc = 8;
-        char** argv = new char*[argc];
-        for (int i=0; i<=argc; i++) {
-            argv[i] = new char[200];
-        }
-        strcpy(argv[0],"./ale");
-        strcpy(argv[1],"-player_agent");
-        strcpy(argv[2],"random_agent");
-        strcpy(argv[3],"-display_screen");
-        if (display_screen) strcpy(argv[4],"true");
-        else                strcpy(argv[4],"false");
-        strcpy(argv[5],"-process_screen");
-        if (process_screen) strcpy(argv[6],"true");
-        else                strcpy(argv[6],"false");
-        strcpy(argv[7],rom_file.c_str());  
+        ALEConfig config;
+        config.display_screen = display_screen;
+        config.process_screen = process_screen;
+        return loadROM(rom_file, config);
+    }
+
+    // Loads and initializes a game using the given configuration. The
+    // configuration is written straight into the settings, over those of
+    // the default settings file; no command line is built or parsed.
+    bool loadROM(const string& rom_file, const ALEConfig& config) {
+        display_active = config.display_screen;
+        process_screen = config.process_screen;
+        frame_skip = config.frame_skip;
+        observation_mode = config.observation_mode;
 
         cout << welcomeMessage() << endl;
     
+        // The controller and the settings both refer to the old OSystem
+        if (exporter) { delete exporter; exporter = NULL; episode_video = NULL; }
+        video_prefix = "";
+        if (action_trace) { delete action_trace; action_trace = NULL; }
+        if (preprocessor) { delete preprocessor; preprocessor = NULL; }
+        if (screen_history) { delete screen_history; screen_history = NULL; }
+        if (game_settings) { delete game_settings; game_settings = NULL; }
+        if (game_controller) { delete game_controller; game_controller = NULL; }
         if (theOSystem) delete theOSystem;
+        if (theSettings) delete theSettings;
+
+        // Everything in the old arena is gone; the emulator objects created
+        // from here on go to the new one, or to the heap without one
+        if (arena && !arena->createdWith(config.arena_size, config.arena_huge_pages)) {
+            delete arena;
+            arena = NULL;
+        }
+        if (!arena && config.arena_size > 0)
+            arena = new EnvArena(config.arena_size, config.arena_huge_pages);
+        EnvArena::Scope arena_scope(arena);
 
 #ifdef WIN32
         theOSystem = new OSystemWin32();
-        SettingsWin32 settings(theOSystem);
+        theSettings = new SettingsWin32(theOSystem);
 #else
         theOSystem = new OSystemUNIX();
-        SettingsUNIX settings(theOSystem);
+        theSettings = new SettingsUNIX(theOSystem);
 #endif
 
-        setDefaultSettings(theOSystem->settings());
-
-        theOSystem->settings().loadConfig();
+        setDefaultSettings(*theSettings);
 
-        // process commandline arguments, which over-ride all possible config file settings
-        string romfile = theOSystem->settings().loadCommandLine(argc, argv);
+        // The default settings file first, as the command line does
+        theSettings->loadConfig();
+        if (!config.config_file.empty())
+            theSettings->loadConfig(config.config_file.c_str());
 
-        // Load the configuration from a config file (passed on the command
-        //  line), if provided
-        string configFile = theOSystem->settings().getString("config", false);
-   
-        if (!configFile.empty())
-            theOSystem->settings().loadConfig(configFile.c_str());
+        config.apply(*theSettings);
 
-        theOSystem->settings().validate();
+        theSettings->validate();
         theOSystem->create();
   
-        //// Main loop ////
-        // First we check if a ROM is specified on the commandline.  If so, and if
-        //   the ROM actually exists, use it to create a new console.
-        // If not, use the built-in ROM launcher.  In this case, we enter 'launcher'
-        //   mode and let the main event loop take care of opening a new console/ROM.
-        if(argc == 1 || romfile == "" || !FilesystemNode::fileExists(romfile)) {
+        if (rom_file == "" || !FilesystemNode::fileExists(rom_file)) {
             printf("No ROM File specified or the ROM file was not found.\n");
             return false;
-        } else if(theOSystem->createConsole(romfile)) 	{
+        } else if(theOSystem->createConsole(rom_file)) 	{
             printf("Running ROM file...\n");
-            theOSystem->settings().setString("rom_file", romfile);
+            theSettings->setString("rom_file", rom_file);
         } else {
             printf("Unable to create console from ROM file.\n");
             return false;
         }
 
         // Seed the Random number generator
-        if (theOSystem->settings().getString("random_seed") == "time") {
+        if (config.random_seed < 0) {
             cout << "Random Seed: Time" << endl;
-            srand((unsigned)time(0)); 
-            //srand48((unsigned)time(0));
+            random_seed = (int)time(0);
         } else {
-            int seed = theOSystem->settings().getInt("random_seed");
-            assert(seed >= 0);
-            cout << "Random Seed: " << seed << endl;
-            srand((unsigned)seed); 
-            //srand48((unsigned)seed);
+            cout << "Random Seed: " << config.random_seed << endl;
+            random_seed = config.random_seed;
         }
+        srand((unsigned)random_seed);
 
         // Generate the GameController
-        if (game_controller) delete game_controller;
         game_controller = new InternalController(theOSystem);
         theOSystem->setGameController(game_controller);
 
@@ -165,22 +209,17 @@ public:
         mediasrc = &theOSystem->console().mediaSource();
         screen_width = mediasrc->width();
         screen_height = mediasrc->height();
-        for (int i=0; i<screen_height; ++i) { // Initialize our screen matrix
-            IntVect row;
-            for (int j=0; j<screen_width; ++j)
-                row.push_back(-1);
-            screen_matrix.push_back(row);
-        }
+        screen_matrix.assign(screen_height, IntVect(screen_width, -1));
+        rows_changed.assign(screen_height, 1);
 
         // Intialize the ram array
-        for (int i=0; i<RAM_LENGTH; i++)
-            ram_content.push_back(0);
+        ram_content.assign(RAM_LENGTH, 0);
 
         emulator_system = &theOSystem->console().system();
         game_settings = buildRomRLWrapper(theOSystem->romFile());
         visProc = theOSystem->p_vis_proc;
         allowed_actions = game_settings->getAvailableActions();
-        max_num_frames = theOSystem->settings().getInt("max_num_frames", true);
+        max_num_frames = config.max_num_frames;
     
         reset_game();
 
@@ -189,26 +228,22 @@ public:
 
     // Resets the game
     void reset_game() {
-        game_controller->systemReset();
+        resetEmulator();
         
-        game_settings->step(*emulator_system);
-        
-        // Get the first screen
-        mediasrc->update();
-        int ind_i, ind_j;
-        uInt8* pi_curr_frame_buffer = mediasrc->currentFrameBuffer();
-        for (int i = 0; i < screen_width * screen_height; i++) {
-            uInt8 v = pi_curr_frame_buffer[i];
-            ind_i = i / screen_width;
-            ind_j = i - (ind_i * screen_width);
-            screen_matrix[ind_i][ind_j] = v;
+        // Get the first screen and ram content
+        copyObservation();
+        if (preprocessor)
+            preprocessor->fill(mediasrc->currentFrameBuffer(), mediasrc->previousFrameBuffer());
+        if (screen_history) {
+            screen_history->clear();
+            screen_history->push(mediasrc->currentFrameBuffer());
         }
-
-        // Get the first ram content
-        for(int i = 0; i<RAM_LENGTH; i++) {
-            int offset = i;
-            offset &= 0x7f; // there are only 128 bytes
-            ram_content[i] = emulator_system->peek(offset + 0x80);
+        game_controller->recordStep(PLAYER_A_NOOP, 0, DATASET_EPISODE_START);
+        if (video_prefix != "")
+            beginEpisodeVideo();
+        if (action_trace) {
+            action_trace->addReset();
+            action_trace->addSnapshot(saveSnapshot());
         }
 
         // Record the starting time of this game
@@ -224,36 +259,74 @@ public:
     // to check if the game has ended and reset when necessary -- this method will keep pressing
     // buttons on the game over screen.
     float act(Action action) {
-        frame++;
-        float action_reward = 0;
-            
-        game_settings->step(*emulator_system);
-
-        // Apply action to simulator and update the simulator
-        game_controller->getState()->apply_action(action, PLAYER_B_NOOP);
+        // getRAMChanges covers the frames of this action only
+        M6532& riot = theOSystem->console().riot();
+        if (riot.tracksRAMWrites())
+            riot.clearRAMChanges();
+
+        int start_frame = frame;
+        float action_reward = emulate(action);
+        finishStep(action, action_reward, start_frame);
+        return action_reward;
+    }
 
-        // Get the latest screen
+    // Resets the emulator and the RomSettings, without observing or
+    // recording anything
+    void resetEmulator() {
+        game_controller->systemReset();
+        game_settings->step(*emulator_system);
         mediasrc->update();
-        int ind_i, ind_j;
-        uInt8* pi_curr_frame_buffer = mediasrc->currentFrameBuffer();
-        for (int i = 0; i < screen_width * screen_height; i++) {
-            uInt8 v = pi_curr_frame_buffer[i];
-            ind_i = i / screen_width;
-            ind_j = i - (ind_i * screen_width);
-            screen_matrix[ind_i][ind_j] = v;
-        }
+        rows_changed.assign(screen_height, 1);
+    }
 
-        // Get the latest ram content
-        for(int i = 0; i<RAM_LENGTH; i++) {
-            int offset = i;
-            offset &= 0x7f; // there are only 128 bytes
-            ram_content[i] = emulator_system->peek(offset + 0x80);
+    // Emulates the frames of one step and returns the reward, without
+    // observing or recording anything. The action is held for frame_skip
+    // extra frames, unless the game ends.
+    float emulate(Action action) {
+        float action_reward = 0;
+        for (int f = 0; f <= frame_skip; f++) {
+            frame++;
+            game_settings->step(*emulator_system);
+
+            // Apply action to simulator and update the simulator
+            game_controller->getState()->apply_action(action, PLAYER_B_NOOP);
+            mediasrc->update();
+
+            const uInt8* changes = mediasrc->scanlineChanges();
+            for (int i = 0; i < screen_height; i++)
+                rows_changed[i] |= changes[i];
+
+            // Get the reward
+            action_reward += game_settings->getReward();
+            if (game_settings->isTerminal())
+                break;
         }
+        return action_reward;
+    }
 
-        // Get the reward
-        action_reward += game_settings->getReward();
+    // Everything act() does once the frames of a step were emulated: the
+    // observations, recordings, display and score. Also used for environments
+    // put in the state another one reached (see ALELockstepBatch), so that
+    // they behave as if they had been stepped; rows_changed and frame must
+    // have been updated first.
+    void finishStep(Action action, float action_reward, int start_frame) {
+        // Get the latest screen and ram content
+        copyObservation();
+        if (preprocessor)
+            preprocessor->push(mediasrc->currentFrameBuffer(), mediasrc->previousFrameBuffer());
+        if (screen_history)
+            screen_history->push(mediasrc->currentFrameBuffer());
+        game_controller->recordStep(action, (reward_t)action_reward,
+                                    game_over() ? DATASET_TERMINAL : 0);
+        if (episode_video)
+            exporter->addFrame(episode_video, mediasrc->currentFrameBuffer());
+        if (action_trace) {
+            action_trace->addAction(action);
+            if (action_trace->needsSnapshot())
+                action_trace->addSnapshot(saveSnapshot());
+        }
 
-        if (frame % 1000 == 0) {
+        if (frame / 1000 > start_frame / 1000) {
             time_end = time(NULL);
             double avg = ((double)frame)/(time_end - time_start);
             cout << "Average main loop iterations per sec = " << avg << endl;
@@ -270,7 +343,318 @@ public:
 
         game_score += action_reward;
         last_action = action;
-        return action_reward;
+    }
+
+    // Observes the current screen afresh, e.g. once it was replaced: every
+    // row is copied, and the preprocessed stack and the history restart
+    // from it
+    void refreshObservation() {
+        rows_changed.assign(screen_height, 1);
+        copyObservation();
+        if (preprocessor)
+            preprocessor->fill(mediasrc->currentFrameBuffer(), mediasrc->previousFrameBuffer());
+        if (screen_history) {
+            screen_history->clear();
+            screen_history->push(mediasrc->currentFrameBuffer());
+        }
+    }
+
+    // Copies the current screen and ram content into screen_matrix and
+    // ram_content, as selected by the observation mode. Only the screen
+    // rows which changed since the last copy are updated.
+    void copyObservation() {
+        if (observation_mode == OBSERVE_SCREEN_AND_RAM || observation_mode == OBSERVE_SCREEN) {
+            uInt8* pi_curr_frame_buffer = mediasrc->currentFrameBuffer();
+            for (int i = 0; i < screen_height; i++) {
+                if (!rows_changed[i]) continue;
+                const uInt8* row = pi_curr_frame_buffer + i * screen_width;
+                IntVect& matrix_row = screen_matrix[i];
+                for (int j = 0; j < screen_width; j++)
+                    matrix_row[j] = row[j];
+                rows_changed[i] = 0;
+            }
+        }
+
+        if (observation_mode == OBSERVE_SCREEN_AND_RAM || observation_mode == OBSERVE_RAM) {
+            for(int i = 0; i<RAM_LENGTH; i++) {
+                int offset = i;
+                offset &= 0x7f; // there are only 128 bytes
+                ram_content[i] = emulator_system->peek(offset + 0x80);
+            }
+        }
+    }
+
+    // The RAM bytes whose value changed during the last act(), as four words
+    // of 32 bits: bit i & 31 of word i / 32 stands for byte i. Only recorded
+    // if loadROM was given track_ram_writes; all zero otherwise.
+    const uInt32* getRAMChanges() const {
+        return theOSystem->console().riot().ramChanges();
+    }
+
+    // The number of writes to each of the 128 RAM bytes since the ROM was
+    // loaded or the counts were cleared, e.g. for count-based novelty
+    // bonuses. Only recorded if loadROM was given track_ram_writes.
+    const uInt32* getRAMWriteCounts() const {
+        return theOSystem->console().riot().ramWriteCounts();
+    }
+
+    void clearRAMWriteCounts() {
+        theOSystem->console().riot().clearRAMWriteCounts();
+    }
+
+    // Turns on the grayscale/crop/resize/stack preprocessing of the screen.
+    // Must be called after loadROM; the stack starts with the current screen.
+    void setPreprocessing(const PreprocessConfig& config) {
+        if (preprocessor) delete preprocessor;
+        preprocessor = new ScreenPreprocessor(config, screen_width, screen_height,
+                                              *theOSystem->p_export_screen);
+        preprocessor->fill(mediasrc->currentFrameBuffer(), mediasrc->previousFrameBuffer());
+    }
+
+    // Writes the preprocessed current screen into out, which must hold
+    // preprocessor->frameSize() bytes
+    void getPreprocessedScreen(uInt8* out) {
+        assert(preprocessor);
+        preprocessor->process(mediasrc->currentFrameBuffer(), mediasrc->previousFrameBuffer(), out);
+    }
+
+    // Writes the last frame_stack preprocessed screens, oldest first, into
+    // out, which must hold preprocessor->stackSize() bytes
+    void getStackedScreens(uInt8* out) {
+        assert(preprocessor);
+        preprocessor->copyStack(out);
+    }
+
+    // Keeps the last 'length' raw screens (palette indices) in a ring.
+    // Must be called after loadROM; the history starts with the current screen.
+    void setObservationHistory(int length) {
+        if (screen_history) delete screen_history;
+        screen_history = new ObservationHistory(screen_width * screen_height, length);
+        screen_history->push(mediasrc->currentFrameBuffer());
+    }
+
+    // Views of the last k observations, oldest first, without copying: the
+    // preprocessed frames if setPreprocessing was called, the raw screens
+    // otherwise. The views are only valid until the next act or reset.
+    StackedObservation getStackedObservation(int k) {
+        if (preprocessor)
+            return preprocessor->getStack(k);
+        assert(screen_history);
+        return screen_history->getStackedObservation(k);
+    }
+
+    // Saves the current screen as a PNG file. The file is compressed and
+    // written by a background thread; see ScreenExporter.
+    void saveScreenPNG(const string& filename) {
+        if (!exporter) exporter = new ScreenExporter(*theOSystem->p_export_screen,
+                                                     screen_width, screen_height);
+        exporter->savePNG(mediasrc->currentFrameBuffer(), filename);
+    }
+
+    // Records every episode from the current one on as an animated PNG,
+    // prefix_<n>.png, compressed by num_threads background threads. An
+    // empty prefix stops recording. Must be called after loadROM.
+    void recordEpisodeVideos(const string& prefix, int num_threads = 1) {
+        if (exporter) delete exporter;
+        exporter = new ScreenExporter(*theOSystem->p_export_screen, screen_width,
+                                      screen_height, num_threads);
+        episode_video = NULL;
+        video_prefix = prefix;
+        if (video_prefix != "")
+            beginEpisodeVideo();
+    }
+
+    // Ends the current episode's video and starts the next one with the
+    // current screen
+    void beginEpisodeVideo() {
+        exporter->endVideo(episode_video);
+        ostringstream filename;
+        filename << video_prefix << "_" << video_episode++ << ".png";
+        episode_video = exporter->beginVideo(filename.str(), 60 / (frame_skip + 1));
+        exporter->addFrame(episode_video, mediasrc->currentFrameBuffer());
+    }
+
+    // Takes the state of the environment into snapshot, the screen only
+    // if with_screen
+    void takeSnapshot(ALESnapshot& snapshot, bool with_screen = true) {
+        ALEState* state = game_controller->getState();
+        state->save();
+        snapshot.emulator = state->getSerialized();
+
+        Serializer ser;
+        game_settings->saveState(ser);
+        snapshot.rom_state = ser.get_str();
+
+        // The screen is not part of the emulator state
+        if (with_screen) {
+            const uInt8* screen = mediasrc->currentFrameBuffer();
+            snapshot.screen.assign(screen, screen + screen_width * screen_height);
+        } else {
+            snapshot.screen.clear();
+        }
+        snapshot.frame = frame;
+        snapshot.game_score = game_score;
+    }
+
+    // Restores a snapshot taken on an environment of the same ROM. Without
+    // restore_screen, or if the snapshot has no screen, the screen and the
+    // observations are left as they are, which is cheaper when only rewards
+    // and game ends matter (e.g. rollouts).
+    void restoreSnapshot(const ALESnapshot& snapshot, bool restore_screen = true) {
+        ALEState* state = game_controller->getState();
+        state->setSerialized(snapshot.emulator);
+        state->load();
+
+        Deserializer deser(snapshot.rom_state);
+        game_settings->loadState(deser);
+        frame = snapshot.frame;
+        game_score = snapshot.game_score;
+        if (!restore_screen || snapshot.screen.empty()) return;
+
+        memcpy(mediasrc->currentFrameBuffer(), &snapshot.screen[0], snapshot.screen.size());
+        memset(mediasrc->scanlineChanges(), 1, screen_height);
+        refreshObservation();
+    }
+
+    // Serializes the whole environment: the emulator, both RomSettings, the
+    // current screen and the frame and score counters
+    string saveSnapshot() {
+        ALESnapshot snapshot;
+        takeSnapshot(snapshot, false);
+
+        Serializer ser;
+        ser.putString(snapshot.emulator);
+        ser.putString(snapshot.rom_state);
+        ser.putInt(snapshot.frame);
+        ser.putDouble(snapshot.game_score);
+
+        uLongf size = compressBound(screen_width * screen_height);
+        string screen(size, '\0');
+        compress((Bytef*)&screen[0], &size, mediasrc->currentFrameBuffer(),
+                 screen_width * screen_height);
+        screen.resize(size);
+        ser.putString(screen);
+        return ser.get_str();
+    }
+
+    // Restores an environment saved by saveSnapshot; see restoreSnapshot
+    // above for restore_screen
+    void restoreSnapshot(const string& serialized, bool restore_screen = true) {
+        ALESnapshot snapshot;
+        Deserializer deser(serialized);
+        snapshot.emulator = deser.getString();
+        snapshot.rom_state = deser.getString();
+        snapshot.frame = deser.getInt();
+        snapshot.game_score = deser.getDouble();
+        if (restore_screen) {
+            string screen = deser.getString();
+            uLongf size = screen_width * screen_height;
+            snapshot.screen.resize(size);
+            uncompress(&snapshot.screen[0], &size, (const Bytef*)screen.data(), screen.size());
+        }
+        restoreSnapshot(snapshot, restore_screen);
+    }
+
+    // Writes the environment's state into blob in a portable format, which
+    // importState accepts on any host running the same ROM: the emulator,
+    // both RomSettings, the paddles and the frame and score counters, but
+    // not the screen. See state_blob.h for the layout.
+    void exportState(string& blob, bool compress = false) {
+        Serializer ser(true);
+        game_controller->getState()->exportTo(ser);
+        game_settings->saveState(ser);
+        ser.putInt(frame);
+        ser.putDouble(game_score);
+        packStateBlob(ser.get_str(), theOSystem->console().properties().get(Cartridge_MD5),
+                      compress, blob);
+    }
+
+    // Restores a state written by exportState. Returns false if the blob
+    // is damaged or for another ROM, in which case the environment is put
+    // back as it was. The screen is not restored.
+    bool importState(const string& blob) {
+        string payload;
+        if (!unpackStateBlob(blob, theOSystem->console().properties().get(Cartridge_MD5),
+                             payload))
+            return false;
+
+        // The payload is read straight into the emulator, which a damaged
+        // one can leave half overwritten
+        ALESnapshot previous;
+        takeSnapshot(previous, false);
+
+        Deserializer deser(payload, true);
+        try {
+            if (game_controller->getState()->importFrom(deser)) {
+                game_settings->loadState(deser);
+                frame = deser.getInt();
+                game_score = deser.getDouble();
+                return true;
+            }
+        }
+        catch (const char* msg) {
+            cerr << msg << endl;
+        }
+        restoreSnapshot(previous, false);
+        return false;
+    }
+
+    // Starts writing every action and reset to an action trace, with a
+    // snapshot every snapshot_interval steps; see ActionTraceWriter. An
+    // empty filename stops recording. Must be called after loadROM.
+    void recordActionTrace(const string& filename, int snapshot_interval = 1000) {
+        if (action_trace) { delete action_trace; action_trace = NULL; }
+        if (filename == "") return;
+
+        action_trace = new ActionTraceWriter(filename,
+            theOSystem->console().properties().get(Cartridge_MD5), random_seed,
+            frame_skip, snapshot_interval);
+        action_trace->addSnapshot(saveSnapshot());
+    }
+
+    // Puts the environment in the state reached after the first 'step' steps
+    // of the trace, by restoring the closest snapshot and replaying the steps
+    // after it. The replayed steps are only emulated: they are not recorded
+    // or observed, and the observations start afresh from the last screen.
+    // Returns false if the trace could not be read, is of another ROM or
+    // frame skip or holds an invalid step, or the step is out of range, in
+    // which case the environment is left as it was.
+    bool seekActionTrace(const ActionTraceReader& trace, int step) {
+        if (!trace.ok())
+            return false;
+        if (step < 0 || step > trace.size()) {
+            cerr << "Step " << step << " is not in the action trace" << endl;
+            return false;
+        }
+        if (trace.romMD5() != theOSystem->console().properties().get(Cartridge_MD5) ||
+            trace.frameSkip() != frame_skip) {
+            cerr << "The action trace was recorded with another ROM or frame skip" << endl;
+            return false;
+        }
+
+        int current;
+        const string& snapshot = trace.snapshotBefore(step, current);
+        for (int s = current; s < step; s++) {
+            int entry = trace.step(s);
+            if (entry != TRACE_RESET && entry >= PLAYER_B_NOOP && entry != RESET) {
+                cerr << "Step " << s << " of the action trace is not an action" << endl;
+                return false;
+            }
+        }
+
+        restoreSnapshot(snapshot);
+        if (current == step) return true;
+
+        for (; current < step; current++) {
+            if (trace.step(current) == TRACE_RESET) {
+                resetEmulator();
+            } else {
+                last_action = (Action)trace.step(current);
+                game_score += emulate(last_action);
+            }
+        }
+        refreshObservation();
+        return true;
     }
 
     //****************** Visual Processing Methods ********************//
@@ -0,0 +1,178 @@
+#ifndef ALE_LOCKSTEP_H
+#define ALE_LOCKSTEP_H
+
+#include <algorithm>
+#include "ale_interface.hpp"
+
+/**
+   Runs a batch of environments ("lanes") playing the same ROM in lockstep.
+
+   Lanes which are known to be in the same state and are given the same
+   action are emulated once: the first lane of such a group runs the frame
+   and the others copy the resulting state. Lanes which diverge fall back
+   to being emulated on their own. Groups are only formed on reset and only
+   ever split, so the saving is largest when many lanes follow the same
+   action sequence (evaluation runs, shared prefixes). Lanes which copy a
+   state still go through ALEInterface::finishStep, so their observations,
+   recordings and scores are those of a stepped lane.
+
+   After every step the RIOT RAM of all lanes is gathered into one
+   structure-of-arrays block, byte-major, so that a batched agent reads a
+   given RAM location of every lane contiguously.
+ */
+class ALELockstepBatch
+{
+public:
+    vector<ALEInterface*> lanes;
+    vector<int> lane_group;      // Lanes with the same group id are in the same state
+    vector<uInt8> ram_soa;       // RAM byte b of lane l is at ram_soa[b * lanes.size() + l]
+    int num_groups;              // Number of emulations needed by the last step
+
+public:
+    ALELockstepBatch(): num_groups(0) {
+    }
+
+    ~ALELockstepBatch() {
+        for (size_t l = 0; l < lanes.size(); l++)
+            delete lanes[l];
+    }
+
+    // Loads the ROM into num_lanes environments and resets them. RAM write
+    // tracking is not supported: lanes which follow another one do not
+    // emulate, so they would not see the writes.
+    bool loadROM(const string& rom_file, int num_lanes, const ALEConfig& config) {
+        assert(num_lanes > 0);
+        if (config.track_ram_writes) {
+            cerr << "Lockstep lanes cannot track RAM writes" << endl;
+            return false;
+        }
+        for (int l = 0; l < num_lanes; l++) {
+            ALEInterface* lane = new ALEInterface();
+            lanes.push_back(lane);
+            if (!lane->loadROM(rom_file, config))
+                return false;
+        }
+
+        ram_soa.assign(RAM_LENGTH * lanes.size(), 0);
+        regroup();
+        gatherRam();
+        return true;
+    }
+
+    int numLanes() const { return lanes.size(); }
+
+    // Resets every lane
+    void reset_game() {
+        for (size_t l = 0; l < lanes.size(); l++)
+            lanes[l]->reset_game();
+        regroup();
+        gatherRam();
+    }
+
+    // Resets one lane, which leaves its group
+    void reset_lane(int lane) {
+        lanes[lane]->reset_game();
+        lane_group[lane] = *std::max_element(lane_group.begin(), lane_group.end()) + 1;
+
+        System* system = lanes[lane]->emulator_system;
+        int n = lanes.size();
+        for (int b = 0; b < RAM_LENGTH; b++)
+            ram_soa[b * n + lane] = system->peek(0x80 + b);
+    }
+
+    // Applies actions[l] to lane l and stores its reward in rewards[l]
+    void act(const ActionVect& actions, vector<float>& rewards) {
+        int n = lanes.size();
+        assert((int)actions.size() == n);
+        rewards.resize(n);
+
+        vector<int> new_group(n, -1);
+        num_groups = 0;
+        for (int i = 0; i < n; i++) {
+            if (new_group[i] >= 0) continue;
+
+            // Lane i leads the lanes of its group which take the same action
+            new_group[i] = num_groups;
+            rewards[i] = lanes[i]->act(actions[i]);
+
+            ALESnapshot snapshot;
+            bool saved = false;
+            for (int j = i + 1; j < n; j++) {
+                if (new_group[j] >= 0 || lane_group[j] != lane_group[i] ||
+                    actions[j] != actions[i])
+                    continue;
+
+                if (!saved) {
+                    lanes[i]->takeSnapshot(snapshot, false);
+                    saved = true;
+                }
+                follow(j, i, snapshot, rewards[i]);
+                rewards[j] = rewards[i];
+                new_group[j] = num_groups;
+            }
+            num_groups++;
+        }
+
+        lane_group.swap(new_group);
+        gatherRam();
+    }
+
+protected:
+    // Groups the lanes whose saved states are identical
+    void regroup() {
+        int n = lanes.size();
+        vector<ALESnapshot> snapshots(n);
+        for (int l = 0; l < n; l++)
+            lanes[l]->takeSnapshot(snapshots[l], false);
+
+        lane_group.assign(n, -1);
+        num_groups = 0;
+        for (int i = 0; i < n; i++) {
+            if (lane_group[i] >= 0) continue;
+            lane_group[i] = num_groups;
+            for (int j = i + 1; j < n; j++) {
+                if (lane_group[j] < 0 && snapshots[j].rom_state == snapshots[i].rom_state &&
+                    snapshots[j].emulator == snapshots[i].emulator)
+                    lane_group[j] = num_groups;
+            }
+            num_groups++;
+        }
+    }
+
+    // Puts a lane in the state its leader has just reached, given a
+    // snapshot of the leader without its screen
+    void follow(int lane, int leader, const ALESnapshot& snapshot, float reward) {
+        ALEInterface* f = lanes[lane];
+        ALEInterface* l = lanes[leader];
+
+        // The lane keeps its own score, which finishStep adds the reward to
+        int start_frame = f->frame;
+        float game_score = f->game_score;
+        f->restoreSnapshot(snapshot, false);
+        f->game_score = game_score;
+
+        // The frame buffers are not part of the snapshot
+        int frame_size = l->screen_width * l->screen_height;
+        memcpy(f->mediasrc->currentFrameBuffer(), l->mediasrc->currentFrameBuffer(), frame_size);
+        memcpy(f->mediasrc->previousFrameBuffer(), l->mediasrc->previousFrameBuffer(), frame_size);
+        memcpy(f->mediasrc->scanlineChanges(), l->mediasrc->scanlineChanges(), l->screen_height);
+
+        // The lane then observes, records and scores the step as act() would.
+        // The rows the leader saw change in the skipped frames are not known
+        // any more, so every row is copied.
+        f->rows_changed.assign(f->screen_height, 1);
+        f->finishStep(l->last_action, reward, start_frame);
+    }
+
+    // Copies the RAM of every lane into ram_soa
+    void gatherRam() {
+        int n = lanes.size();
+        for (int l = 0; l < n; l++) {
+            System* system = lanes[l]->emulator_system;
+            for (int b = 0; b < RAM_LENGTH; b++)
+                ram_soa[b * n + l] = system->peek(0x80 + b);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,525 @@
+#ifndef ALE_MULTI_SERVER_H
+#define ALE_MULTI_SERVER_H
+
+#include <map>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "ale_interface.hpp"
+
+/**
+   Hosts many environments playing the same ROM in one process, behind a
+   local socket. A single epoll loop serves all connections; every request
+   may address any number of environments, so one round trip can step
+   hundreds of them.
+
+   The address is either the path of a Unix socket, or "tcp:PORT" for a
+   loopback TCP port. Linux only (epoll).
+
+   Protocol. Every message, in either direction, is a uint32 payload length
+   followed by the payload. All values are in the host's byte order (the
+   server only listens locally). A request starts with a uint8 opcode; a
+   reply starts with a uint8 status, ALE_STATUS_OK or ALE_STATUS_ERROR, and
+   an error reply carries the error text as the rest of its payload.
+   Requests are answered in order; clients may pipeline them. A request
+   with an invalid entry is rejected as a whole, before any of it runs.
+
+     INFO     ->  u32 num_envs, u32 width, u32 height, u32 n, n x i32 action
+     STEP     u8 obs, u32 n, n x {u32 env, i32 action}  ->  u32 n, n x result
+     RESET    u8 obs, u32 n, n x u32 env                ->  u32 n, n x result
+     CLONE    u32 n, n x u32 env                        ->  u32 n, n x u32 snapshot
+     RESTORE  u8 obs, u32 n, n x {u32 env, u32 snapshot} -> u32 n, n x result
+     RELEASE  u32 n, n x u32 snapshot                   ->  u32 n
+
+   A result is a float reward and a uint8 game over flag, followed by the
+   screen (width x height palette indices) if obs has ALE_OBSERVE_SCREEN
+   set, then the RAM (128 bytes) if obs has ALE_OBSERVE_RAM set. RESET and
+   RESTORE report a reward of 0.
+
+   A snapshot holds the full state of an environment and can be restored
+   into any of them. Snapshots belong to the connection which cloned them
+   and are released when it closes. Connections are not given exclusive
+   access to environments; clients sharing a server should agree on which
+   environments each one drives.
+ */
+
+#define ALE_MSG_INFO        0
+#define ALE_MSG_STEP        1
+#define ALE_MSG_RESET       2
+#define ALE_MSG_CLONE       3
+#define ALE_MSG_RESTORE     4
+#define ALE_MSG_RELEASE     5
+
+#define ALE_STATUS_OK       0
+#define ALE_STATUS_ERROR    1
+
+#define ALE_OBSERVE_SCREEN  1
+#define ALE_OBSERVE_RAM     2
+
+#define ALE_MAX_MESSAGE     (64 << 20)
+
+class ALEMultiServer
+{
+public:
+    vector<ALEInterface*> envs;
+
+protected:
+    struct Snapshot {
+        ALESnapshot env;
+        int owner;                 // Connection which cloned it
+    };
+
+    struct Connection {
+        string in;                 // Received bytes not processed yet
+        string out;                // Reply bytes not sent yet
+        size_t out_sent;           // Bytes of 'out' already sent
+        bool want_write;           // Registered for EPOLLOUT
+
+        Connection(): out_sent(0), want_write(false) {}
+    };
+
+    // Bounds-checked reader over a request payload
+    class Reader {
+    public:
+        Reader(const char* data, size_t size): p(data), end(data + size), ok(true) {}
+
+        template<typename T> T get() {
+            T value = T();
+            if (p + sizeof(T) > end) { ok = false; return value; }
+            memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return value;
+        }
+
+        bool good() const { return ok; }
+        bool finished() const { return ok && p == end; }
+
+    private:
+        const char* p;
+        const char* end;
+        bool ok;
+    };
+
+    string address;
+    int listen_fd;
+    int epoll_fd;
+    std::map<int, Connection> connections;
+    std::map<uInt32, Snapshot> snapshots;
+    uInt32 next_snapshot;
+    int screen_width, screen_height;
+
+public:
+    ALEMultiServer(): listen_fd(-1), epoll_fd(-1), next_snapshot(0),
+                      screen_width(0), screen_height(0) {
+    }
+
+    ~ALEMultiServer() {
+        for (std::map<int, Connection>::iterator it = connections.begin();
+             it != connections.end(); ++it)
+            close(it->first);
+        if (listen_fd >= 0) {
+            close(listen_fd);
+            if (!isTcp()) unlink(address.c_str());
+        }
+        if (epoll_fd >= 0) close(epoll_fd);
+        for (size_t e = 0; e < envs.size(); e++)
+            delete envs[e];
+    }
+
+    // Loads the ROM into num_envs environments. Observations are sent
+    // straight from the emulator, so the configuration's observation mode
+    // is ignored.
+    bool loadROM(const string& rom_file, int num_envs, const ALEConfig& config) {
+        ALEConfig env_config = config;
+        env_config.observation_mode = OBSERVE_NONE;
+        for (int e = 0; e < num_envs; e++) {
+            ALEInterface* env = new ALEInterface();
+            envs.push_back(env);
+            if (!env->loadROM(rom_file, env_config))
+                return false;
+        }
+        screen_width = envs[0]->screen_width;
+        screen_height = envs[0]->screen_height;
+        return true;
+    }
+
+    // Serves requests until the process is killed
+    void serve(const string& _address) {
+        address = _address;
+        listen_fd = openListener();
+
+        epoll_fd = epoll_create(64);
+        if (epoll_fd < 0) {
+            perror("A.L.E: epoll_create");
+            exit(1);
+        }
+        watch(listen_fd, EPOLLIN, EPOLL_CTL_ADD);
+
+        cerr << "A.L.E: serving " << envs.size() << " environments on "
+             << address << endl;
+
+        struct epoll_event events[64];
+        for (;;) {
+            int n = epoll_wait(epoll_fd, events, 64, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                perror("A.L.E: epoll_wait");
+                exit(1);
+            }
+
+            for (int i = 0; i < n; i++) {
+                int fd = events[i].data.fd;
+                if (fd == listen_fd) {
+                    acceptConnections();
+                    continue;
+                }
+                if (connections.find(fd) == connections.end())
+                    continue;
+
+                bool alive = true;
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                    alive = receive(fd);
+                if (alive)
+                    alive = flush(fd);
+                if (!alive)
+                    drop(fd);
+            }
+        }
+    }
+
+protected:
+    bool isTcp() const { return address.compare(0, 4, "tcp:") == 0; }
+
+    int openListener() {
+        int fd;
+        if (isTcp()) {
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(atoi(address.c_str() + 4));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            fd = socket(AF_INET, SOCK_STREAM, 0);
+            int one = 1;
+            if (fd >= 0)
+                setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+                perror("A.L.E: cannot bind TCP port");
+                exit(1);
+            }
+        } else {
+            struct sockaddr_un addr;
+            if (address.length() >= sizeof(addr.sun_path)) {
+                cerr << "A.L.E: socket path is too long: " << address << endl;
+                exit(1);
+            }
+            memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            strcpy(addr.sun_path, address.c_str());
+
+            fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            unlink(address.c_str());
+            if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+                perror("A.L.E: cannot bind socket");
+                exit(1);
+            }
+        }
+
+        if (listen(fd, 64) < 0) {
+            perror("A.L.E: listen");
+            exit(1);
+        }
+        setNonBlocking(fd);
+        return fd;
+    }
+
+    static void setNonBlocking(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    void watch(int fd, uInt32 events, int op) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = events;
+        ev.data.fd = fd;
+        if (epoll_ctl(epoll_fd, op, fd, &ev) < 0) {
+            perror("A.L.E: epoll_ctl");
+            exit(1);
+        }
+    }
+
+    void acceptConnections() {
+        for (;;) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    perror("A.L.E: accept");
+                return;
+            }
+            setNonBlocking(fd);
+            if (isTcp()) {
+                int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+            connections[fd] = Connection();
+            watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+        }
+    }
+
+    void drop(int fd) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+        close(fd);
+        connections.erase(fd);
+
+        std::map<uInt32, Snapshot>::iterator it = snapshots.begin();
+        while (it != snapshots.end()) {
+            if (it->second.owner == fd) {
+                snapshots.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Reads what is available and answers every complete request. Returns
+    // false if the connection should be closed.
+    bool receive(int fd) {
+        Connection& conn = connections[fd];
+        char buffer[65536];
+        for (;;) {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                conn.in.append(buffer, n);
+                continue;
+            }
+            if (n == 0) return false;
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+
+        size_t pos = 0;
+        while (conn.in.size() - pos >= sizeof(uInt32)) {
+            uInt32 length;
+            memcpy(&length, conn.in.data() + pos, sizeof(length));
+            if (length == 0 || length > ALE_MAX_MESSAGE) return false;
+            if (conn.in.size() - pos - sizeof(length) < length) break;
+
+            pos += sizeof(length);
+            handle(fd, conn.in.data() + pos, length, conn.out);
+            pos += length;
+        }
+        conn.in.erase(0, pos);
+        return true;
+    }
+
+    // Sends as much of the pending replies as the socket takes. Returns false
+    // if the connection should be closed.
+    bool flush(int fd) {
+        Connection& conn = connections[fd];
+        while (conn.out_sent < conn.out.size()) {
+            ssize_t n = write(fd, conn.out.data() + conn.out_sent,
+                              conn.out.size() - conn.out_sent);
+            if (n > 0) {
+                conn.out_sent += n;
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            return false;
+        }
+
+        if (conn.out_sent == conn.out.size()) {
+            conn.out.clear();
+            conn.out_sent = 0;
+        }
+
+        bool want_write = !conn.out.empty();
+        if (want_write != conn.want_write) {
+            watch(fd, want_write ? (EPOLLIN | EPOLLOUT) : EPOLLIN, EPOLL_CTL_MOD);
+            conn.want_write = want_write;
+        }
+        return true;
+    }
+
+    template<typename T> static void put(string& out, T value) {
+        out.append((const char*)&value, sizeof(T));
+    }
+
+    // Answers one request, appending the framed reply to out
+    void handle(int fd, const char* data, size_t size, string& out) {
+        size_t start = out.size();
+        put<uInt32>(out, 0);
+        put<uInt8>(out, ALE_STATUS_OK);
+
+        Reader in(data, size);
+        string error = dispatch(fd, in, out);
+        if (error.empty() && !in.finished())
+            error = "malformed request";
+
+        if (!error.empty()) {
+            out.resize(start);
+            put<uInt32>(out, 0);
+            put<uInt8>(out, ALE_STATUS_ERROR);
+            out.append(error);
+        }
+
+        uInt32 length = out.size() - start - sizeof(uInt32);
+        memcpy(&out[start], &length, sizeof(length));
+    }
+
+    // Runs one request; returns an error message, or an empty string
+    string dispatch(int fd, Reader& in, string& out) {
+        uInt8 opcode = in.get<uInt8>();
+        if (!in.good()) return "malformed request";
+
+        switch (opcode) {
+            case ALE_MSG_INFO: {
+                const ActionVect& actions = envs[0]->allowed_actions;
+                put<uInt32>(out, envs.size());
+                put<uInt32>(out, screen_width);
+                put<uInt32>(out, screen_height);
+                put<uInt32>(out, actions.size());
+                for (size_t a = 0; a < actions.size(); a++)
+                    put<Int32>(out, actions[a]);
+                return "";
+            }
+
+            case ALE_MSG_STEP: {
+                uInt8 obs = in.get<uInt8>();
+                uInt32 n = in.get<uInt32>();
+                vector<uInt32> env_ids;
+                vector<Int32> actions;
+                for (uInt32 i = 0; i < n && in.good(); i++) {
+                    env_ids.push_back(in.get<uInt32>());
+                    actions.push_back(in.get<Int32>());
+                    if (in.good() && (actions[i] < PLAYER_A_NOOP || actions[i] >= PLAYER_B_NOOP))
+                        return "invalid action";
+                }
+                if (!in.finished()) return "malformed request";
+                if (!validEnvs(env_ids)) return "no such environment";
+
+                put<uInt32>(out, n);
+                for (uInt32 i = 0; i < n; i++) {
+                    float reward = envs[env_ids[i]]->act((Action)actions[i]);
+                    putResult(out, env_ids[i], reward, obs);
+                }
+                return "";
+            }
+
+            case ALE_MSG_RESET: {
+                uInt8 obs = in.get<uInt8>();
+                uInt32 n = in.get<uInt32>();
+                vector<uInt32> env_ids;
+                for (uInt32 i = 0; i < n && in.good(); i++)
+                    env_ids.push_back(in.get<uInt32>());
+                if (!in.finished()) return "malformed request";
+                if (!validEnvs(env_ids)) return "no such environment";
+
+                put<uInt32>(out, n);
+                for (uInt32 i = 0; i < n; i++) {
+                    envs[env_ids[i]]->reset_game();
+                    putResult(out, env_ids[i], 0, obs);
+                }
+                return "";
+            }
+
+            case ALE_MSG_CLONE: {
+                uInt32 n = in.get<uInt32>();
+                vector<uInt32> env_ids;
+                for (uInt32 i = 0; i < n && in.good(); i++)
+                    env_ids.push_back(in.get<uInt32>());
+                if (!in.finished()) return "malformed request";
+                if (!validEnvs(env_ids)) return "no such environment";
+
+                put<uInt32>(out, n);
+                for (uInt32 i = 0; i < n; i++)
+                    put<uInt32>(out, clone(envs[env_ids[i]], fd));
+                return "";
+            }
+
+            case ALE_MSG_RESTORE: {
+                uInt8 obs = in.get<uInt8>();
+                uInt32 n = in.get<uInt32>();
+                vector<uInt32> env_ids;
+                vector<Snapshot*> sources;
+                for (uInt32 i = 0; i < n && in.good(); i++) {
+                    env_ids.push_back(in.get<uInt32>());
+                    std::map<uInt32, Snapshot>::iterator it = snapshots.find(in.get<uInt32>());
+                    if (!in.good()) break;
+                    if (it == snapshots.end() || it->second.owner != fd)
+                        return "no such snapshot";
+                    sources.push_back(&it->second);
+                }
+                if (!in.finished()) return "malformed request";
+                if (!validEnvs(env_ids)) return "no such environment";
+
+                put<uInt32>(out, n);
+                for (uInt32 i = 0; i < n; i++) {
+                    restore(envs[env_ids[i]], *sources[i]);
+                    putResult(out, env_ids[i], 0, obs);
+                }
+                return "";
+            }
+
+            case ALE_MSG_RELEASE: {
+                uInt32 n = in.get<uInt32>();
+                uInt32 released = 0;
+                for (uInt32 i = 0; i < n && in.good(); i++) {
+                    uInt32 id = in.get<uInt32>();
+                    std::map<uInt32, Snapshot>::iterator it = snapshots.find(id);
+                    if (!in.good() || it == snapshots.end() || it->second.owner != fd)
+                        continue;
+                    snapshots.erase(it);
+                    released++;
+                }
+                put<uInt32>(out, released);
+                return "";
+            }
+
+            default:
+                return "unknown request";
+        }
+    }
+
+    void putResult(string& out, uInt32 e, float reward, uInt8 obs) {
+        ALEInterface* env = envs[e];
+        put<float>(out, reward);
+        put<uInt8>(out, env->game_over() ? 1 : 0);
+        if (obs & ALE_OBSERVE_SCREEN)
+            out.append((const char*)env->mediasrc->currentFrameBuffer(),
+                       screen_width * screen_height);
+        if (obs & ALE_OBSERVE_RAM) {
+            for (int b = 0; b < RAM_LENGTH; b++)
+                put<uInt8>(out, env->emulator_system->peek(0x80 + b));
+        }
+    }
+
+    bool validEnvs(const vector<uInt32>& env_ids) const {
+        for (size_t i = 0; i < env_ids.size(); i++)
+            if (env_ids[i] >= envs.size()) return false;
+        return true;
+    }
+
+    uInt32 clone(ALEInterface* env, int owner) {
+        uInt32 id = next_snapshot++;
+        Snapshot& snapshot = snapshots[id];
+        env->takeSnapshot(snapshot.env);
+        snapshot.owner = owner;
+        return id;
+    }
+
+    void restore(ALEInterface* env, const Snapshot& snapshot) {
+        env->restoreSnapshot(snapshot.env);
+    }
+};
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef ALE_ROLLOUT_H
+#define ALE_ROLLOUT_H
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include "ale_interface.hpp"
+
+typedef vector<Action> ActionSequence;
+
+/**
+   Outcome of playing one action sequence from the root state.
+ */
+struct RolloutResult {
+    float total_reward;          // Sum of the rewards along the sequence
+    int depth;                   // Actions taken before stopping
+    bool terminal;               // Whether the game ended, after 'depth' actions
+    string final_state;          // Snapshot of the last state, if asked for
+};
+
+/**
+   Plays many action sequences from one root state in parallel, one
+   emulator per thread. Search agents use it to evaluate the children of a
+   node, or a batch of random playouts, at once.
+
+   The root is a snapshot taken with ALEInterface::saveSnapshot on an
+   environment running the same ROM; each sequence starts from a fresh
+   restore of it. The emulators copy no observations, and the screen is not
+   restored with the root, as rollouts only look at rewards and game ends.
+ */
+class ALERolloutPool
+{
+public:
+    ALERolloutPool(): generation(0), shutting_down(false), job_count(0), next_sequence(0) {
+    }
+
+    ~ALERolloutPool() {
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            shutting_down = true;
+            work_ready.notify_all();
+        }
+        workers.join_all();
+        for (size_t i = 0; i < envs.size(); i++)
+            delete envs[i];
+    }
+
+    // Loads the ROM into one environment per thread and starts the threads.
+    // The environments are created one after the other: console creation
+    // is not thread-safe.
+    bool loadROM(const string& rom_file, int num_threads, const ALEConfig& config) {
+        assert(num_threads > 0 && envs.empty());
+        ALEConfig rollout_config = config;
+        rollout_config.observation_mode = OBSERVE_NONE;
+        rollout_config.display_screen = false;
+        rollout_config.process_screen = false;
+        rollout_config.max_num_frames = 0;
+        rollout_config.record_dataset = "";
+
+        for (int i = 0; i < num_threads; i++) {
+            ALEInterface* env = new ALEInterface();
+            envs.push_back(env);
+            if (!env->loadROM(rom_file, rollout_config))
+                return false;
+        }
+        for (int i = 0; i < num_threads; i++)
+            workers.create_thread(boost::bind(&ALERolloutPool::run, this, envs[i]));
+        return true;
+    }
+
+    int numThreads() const { return envs.size(); }
+
+    // Plays every sequence from root, each for at most max_depth actions
+    // (no limit if max_depth <= 0) or until the game ends, and fills
+    // results in the same order. If keep_final_states is set, the state
+    // each sequence ended in is saved into its result.
+    void rollout(const string& root, const vector<ActionSequence>& sequences,
+                 int max_depth, vector<RolloutResult>& results,
+                 bool keep_final_states = false) {
+        results.resize(sequences.size());
+
+        boost::mutex::scoped_lock lock(mutex);
+        job_root = &root;
+        job_sequences = &sequences;
+        job_results = &results;
+        job_max_depth = max_depth;
+        job_keep_final_states = keep_final_states;
+        job_count = sequences.size();
+        next_sequence = 0;
+        unfinished = sequences.size();
+        generation++;
+        work_ready.notify_all();
+
+        while (unfinished > 0)
+            work_done.wait(lock);
+    }
+
+protected:
+    void run(ALEInterface* env) {
+        int seen_generation = 0;
+        boost::mutex::scoped_lock lock(mutex);
+        while (true) {
+            while (!shutting_down && (generation == seen_generation ||
+                                      next_sequence >= job_count))
+                work_ready.wait(lock);
+            if (shutting_down) return;
+            seen_generation = generation;
+
+            // Sequences are handed out one at a time, so that long and
+            // short ones balance out between the threads
+            while (next_sequence < job_count) {
+                size_t s = next_sequence++;
+                lock.unlock();
+                play(env, (*job_sequences)[s], (*job_results)[s]);
+                lock.lock();
+
+                if (--unfinished == 0)
+                    work_done.notify_all();
+            }
+        }
+    }
+
+    void play(ALEInterface* env, const ActionSequence& sequence, RolloutResult& result) {
+        env->restoreSnapshot(*job_root, false);
+
+        int length = sequence.size();
+        if (job_max_depth > 0 && job_max_depth < length) length = job_max_depth;
+
+        result.total_reward = 0;
+        result.terminal = env->game_over();
+        result.depth = 0;
+        while (!result.terminal && result.depth < length) {
+            result.total_reward += env->act(sequence[result.depth]);
+            result.depth++;
+            result.terminal = env->game_over();
+        }
+
+        // With no action taken the screen was not rendered, but the root has it
+        if (job_keep_final_states)
+            result.final_state = result.depth > 0 ? env->saveSnapshot() : *job_root;
+        else
+            result.final_state.clear();
+    }
+
+protected:
+    vector<ALEInterface*> envs;
+    boost::thread_group workers;
+
+    boost::mutex mutex;
+    boost::condition_variable work_ready;
+    boost::condition_variable work_done;
+    int generation;              // Incremented by every rollout call
+    bool shutting_down;
+
+    // The current rollout call; only valid while it runs
+    const string* job_root;
+    const vector<ActionSequence>* job_sequences;
+    vector<RolloutResult>* job_results;
+    int job_max_depth;
+    bool job_keep_final_states;
+    size_t job_count;            // Number of sequences
+    size_t next_sequence;
+    size_t unfinished;
+};
+
+#endif
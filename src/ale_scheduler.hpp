@@ -0,0 +1,292 @@
+#ifndef ALE_SCHEDULER_H
+#define ALE_SCHEDULER_H
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <boost/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/bind.hpp>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "ale_interface.hpp"
+#include "common/misc_tools.h"
+
+/**
+   Steps a batch of environments playing the same ROM on a pool of worker
+   threads, with control over where they run.
+
+   Each worker is pinned to a core, and workers are spread over the NUMA
+   nodes in turn. Every environment belongs to one worker for its whole
+   life. The worker creates it, so its emulator memory is first touched,
+   and therefore placed, on the worker's own node. Stepping then stays on
+   that node, apart from the read-only ROM image which all environments
+   share. An arena per environment
+   (ALEConfig::arena_size) also keeps each environment's pages together.
+
+   Topology is read from /sys/devices/system/node, limited to the cores the
+   process may run on. Elsewhere, or if it cannot be read, there is one node
+   and workers are not pinned.
+ */
+class ALEScheduler
+{
+public:
+    struct Worker {
+        int cpu;                 // Core the worker is pinned to; -1 if not pinned
+        int node;                // NUMA node of that core
+        vector<int> envs;        // Environments this worker creates and steps
+        long steps;              // Environment steps taken since the stats were reset
+        boost::thread thread;
+    };
+
+    vector<ALEInterface*> envs;
+    vector<Worker*> workers;
+    vector<int> node_ids;        // The NUMA nodes workers were placed on
+
+public:
+    ALEScheduler(): barrier(NULL), command(STOP), actions(NULL), rewards(NULL),
+                    game_over(NULL), load_failed(false), start_millis(0) {
+    }
+
+    // Finishes the current batch and stops the workers, then frees the
+    // environments
+    ~ALEScheduler() {
+        if (barrier) {
+            command = STOP;
+            barrier->wait();
+            for (size_t w = 0; w < workers.size(); w++)
+                workers[w]->thread.join();
+            delete barrier;
+        }
+        for (size_t w = 0; w < workers.size(); w++)
+            delete workers[w];
+        for (size_t e = 0; e < envs.size(); e++)
+            delete envs[e];
+    }
+
+    // Creates num_envs environments on num_workers workers; 0 means one
+    // worker per core available. With pin false workers are placed on
+    // nodes in the same way but not pinned, for comparison.
+    bool loadROM(const string& rom_file, int num_envs, const ALEConfig& config,
+                 int num_workers = 0, bool pin = true) {
+        assert(num_envs > 0 && workers.empty());
+
+        vector<int> cpus, nodes;
+        bool pinnable = readTopology(cpus, nodes);
+        if (num_workers <= 0) num_workers = cpus.size();
+        num_workers = std::min(num_workers, num_envs);
+
+        for (int w = 0; w < num_workers; w++) {
+            Worker* worker = new Worker();
+            worker->cpu = (pin && pinnable) ? cpus[w % cpus.size()] : -1;
+            worker->node = nodes[w % nodes.size()];
+            worker->steps = 0;
+            workers.push_back(worker);
+            if (std::find(node_ids.begin(), node_ids.end(), worker->node) == node_ids.end())
+                node_ids.push_back(worker->node);
+        }
+        envs.assign(num_envs, NULL);
+        for (int e = 0; e < num_envs; e++)
+            workers[e % num_workers]->envs.push_back(e);
+
+        // The workers create their environments, then wait for the first batch
+        barrier = new boost::barrier(num_workers + 1);
+        for (int w = 0; w < num_workers; w++)
+            workers[w]->thread = boost::thread(boost::bind(&ALEScheduler::run, this,
+                                                           workers[w], rom_file, config));
+        barrier->wait();
+
+        resetStats();
+        return !load_failed;
+    }
+
+    int numEnvs() const { return envs.size(); }
+
+    // Applies actions[e] to environment e on its worker. rewards[e] gets its
+    // reward and game_over[e] whether its game ended, in which case it has
+    // been reset already.
+    void act(const ActionVect& actions, vector<float>& rewards, vector<uInt8>& game_over) {
+        assert(actions.size() == envs.size());
+        rewards.resize(envs.size());
+        game_over.resize(envs.size());
+        this->actions = &actions;
+        this->rewards = &rewards;
+        this->game_over = &game_over;
+        runBatch(ACT);
+    }
+
+    // Resets every environment, on its worker
+    void reset_game() {
+        runBatch(RESET);
+    }
+
+    // Starts counting the steps and time reported by report() afresh
+    void resetStats() {
+        for (size_t w = 0; w < workers.size(); w++)
+            workers[w]->steps = 0;
+        start_millis = timeMillis();
+    }
+
+    // Prints the environment steps per second of every node, and in total,
+    // since the stats were last reset
+    void report(std::ostream& out) const {
+        double seconds = std::max(timeMillis() - start_millis, 1L) / 1000.0;
+        long total = 0;
+        for (size_t n = 0; n < node_ids.size(); n++) {
+            int num_workers = 0, num_envs = 0;
+            long steps = 0;
+            for (size_t w = 0; w < workers.size(); w++) {
+                if (workers[w]->node != node_ids[n]) continue;
+                num_workers++;
+                num_envs += workers[w]->envs.size();
+                steps += workers[w]->steps;
+            }
+            total += steps;
+            out << "node " << node_ids[n] << ": " << num_workers << " workers, " << num_envs
+                << " envs, " << (long)(steps / seconds) << " env-steps/sec" << endl;
+        }
+        out << "total: " << workers.size() << " workers, " << envs.size() << " envs, "
+            << (long)(total / seconds) << " env-steps/sec" << endl;
+    }
+
+protected:
+    enum Command { ACT, RESET, STOP };
+
+    void runBatch(Command next) {
+        command = next;
+        barrier->wait();   // Start
+        barrier->wait();   // Done
+    }
+
+    void run(Worker* worker, string rom_file, ALEConfig config) {
+        if (worker->cpu >= 0)
+            pinThread(worker->cpu);
+
+        // Consoles are created one at a time, as creation is not thread-safe
+        for (size_t i = 0; i < worker->envs.size(); i++) {
+            boost::mutex::scoped_lock lock(create_mutex);
+            ALEInterface* env = new ALEInterface();
+            envs[worker->envs[i]] = env;
+            if (!env->loadROM(rom_file, config))
+                load_failed = true;
+        }
+        barrier->wait();
+
+        for (;;) {
+            barrier->wait();
+            if (command == STOP)
+                return;
+
+            // Batches still complete if an environment could not be loaded
+            for (size_t i = 0; i < worker->envs.size() && !load_failed; i++) {
+                int e = worker->envs[i];
+                ALEInterface* env = envs[e];
+                if (command == RESET) {
+                    env->reset_game();
+                    continue;
+                }
+                (*rewards)[e] = env->act((*actions)[e]);
+                (*game_over)[e] = env->game_over();
+                if ((*game_over)[e])
+                    env->reset_game();
+            }
+            if (command == ACT)
+                worker->steps += worker->envs.size();
+            barrier->wait();
+        }
+    }
+
+    // Lists the cores available and their nodes, interleaving the nodes so
+    // that the first workers are spread over all of them. Returns false if
+    // the topology is unknown, in which case threads are not pinned.
+    static bool readTopology(vector<int>& cpus, vector<int>& nodes) {
+        cpus.clear();
+        nodes.clear();
+#ifdef __linux__
+        cpu_set_t allowed;
+        bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        vector<int> online = readList("/sys/devices/system/node/online");
+        vector<vector<int> > node_cpus;
+        vector<int> node_ids;
+        for (size_t n = 0; n < online.size(); n++) {
+            std::ostringstream path;
+            path << "/sys/devices/system/node/node" << online[n] << "/cpulist";
+            vector<int> list = readList(path.str()), usable;
+            for (size_t c = 0; c < list.size(); c++) {
+                if (!have_mask || CPU_ISSET(list[c], &allowed))
+                    usable.push_back(list[c]);
+            }
+            if (!usable.empty()) {
+                node_cpus.push_back(usable);
+                node_ids.push_back(online[n]);
+            }
+        }
+
+        for (size_t i = 0; !node_cpus.empty(); i++) {
+            bool any = false;
+            for (size_t n = 0; n < node_cpus.size(); n++) {
+                if (i >= node_cpus[n].size()) continue;
+                cpus.push_back(node_cpus[n][i]);
+                nodes.push_back(node_ids[n]);
+                any = true;
+            }
+            if (!any) break;
+        }
+        if (!cpus.empty())
+            return true;
+#endif
+        int num_cpus = std::max((int)boost::thread::hardware_concurrency(), 1);
+        for (int c = 0; c < num_cpus; c++) {
+            cpus.push_back(c);
+            nodes.push_back(0);
+        }
+        return false;
+    }
+
+    // Reads a sysfs list such as "0-7,16-23"; empty if the file is missing
+    static vector<int> readList(const string& filename) {
+        vector<int> values;
+        std::ifstream in(filename.c_str());
+        string line;
+        if (!std::getline(in, line))
+            return values;
+
+        std::istringstream items(line);
+        string item;
+        while (std::getline(items, item, ',')) {
+            int first, last;
+            char dash;
+            std::istringstream range(item);
+            if (!(range >> first)) continue;
+            if (!(range >> dash >> last)) last = first;
+            for (int v = first; v <= last; v++)
+                values.push_back(v);
+        }
+        return values;
+    }
+
+    static void pinThread(int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            cerr << "Unable to pin a worker to core " << cpu << endl;
+#endif
+    }
+
+protected:
+    boost::barrier* barrier;     // Starts and ends every batch
+    Command command;             // What the workers do in the next batch
+    const ActionVect* actions;
+    vector<float>* rewards;
+    vector<uInt8>* game_over;
+    boost::mutex create_mutex;
+    bool load_failed;
+    long start_millis;
+};
+
+#endif
@@ -0,0 +1,51 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ALEConfig.cpp 
+ *
+ *  Typed configuration for programmatic users of ALE.
+ *
+ **************************************************************************** */
+#include "ALEConfig.hpp"
+
+ALEConfig::ALEConfig():
+    random_seed(-1),
+    frame_skip(0),
+    system_reset_steps(2),
+    max_num_frames(50000),
+    max_num_frames_per_episode(0),
+    player_agent("random_agent"),
+    display_screen(false),
+    process_screen(false),
+    observation_mode(OBSERVE_SCREEN_AND_RAM),
+    dataset_keyframe_interval(64),
+    track_ram_writes(false),
+    arena_size(0),
+    arena_huge_pages(false) {
+}
+
+void ALEConfig::apply(Settings& settings) const {
+    if (random_seed < 0)
+        settings.setString("random_seed", "time");
+    else
+        settings.setInt("random_seed", random_seed);
+
+    settings.setInt("system_reset_steps", system_reset_steps);
+    settings.setInt("max_num_frames", max_num_frames);
+    settings.setInt("max_num_frames_per_episode", max_num_frames_per_episode);
+    settings.setString("player_agent", player_agent);
+    if (!controller.empty())
+        settings.setString("bc", controller);
+    settings.setBool("display_screen", display_screen);
+    settings.setBool("process_screen", process_screen);
+    settings.setString("record_dataset", record_dataset);
+    settings.setInt("dataset_keyframe_interval", dataset_keyframe_interval);
+    settings.setBool("track_ram_writes", track_ram_writes);
+}
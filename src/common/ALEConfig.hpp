@@ -0,0 +1,60 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ALEConfig.hpp 
+ *
+ *  Typed configuration for programmatic users of ALE. Lets a library caller
+ *  set up an environment without building (and parsing) a fake command line.
+ *
+ **************************************************************************** */
+
+#ifndef __ALE_CONFIG_HPP__
+#define __ALE_CONFIG_HPP__
+
+#include <string>
+#include "../emucore/Settings.hxx"
+
+/** What the interface copies out of the emulator after every act() */
+enum ObservationMode {
+    OBSERVE_SCREEN_AND_RAM,
+    OBSERVE_SCREEN,
+    OBSERVE_RAM,
+    OBSERVE_NONE
+};
+
+struct ALEConfig {
+    int random_seed;             // Seed for the random generators; -1 seeds from the time
+    int frame_skip;              // Extra frames each act() repeats its action for
+    int system_reset_steps;      // Number of RESET presses when resetting the system
+    int max_num_frames;          // Frame limit for the whole run; 0 means no limit
+    int max_num_frames_per_episode; // Frame limit per episode; 0 means no limit
+    std::string player_agent;    // Agent built by the internal controller
+    std::string controller;      // Controller in both ports (e.g. "Joystick", "Paddles");
+                                 // empty keeps the one given by the ROM's properties
+    std::string config_file;     // Optional Stella rc-file, loaded before the fields below
+    bool display_screen;         // Should the screen be displayed or not
+    bool process_screen;         // Should visual processing be performed or not
+    ObservationMode observation_mode;
+    std::string record_dataset;  // File the episodes are streamed to; empty disables
+    int dataset_keyframe_interval; // Records between two full screens in the dataset
+    bool track_ram_writes;       // Record which RAM bytes each step changes; slower
+    int arena_size;              // Bytes of the arena holding the emulator objects; 0 uses
+                                 // the heap, and 256K holds them all
+    bool arena_huge_pages;       // Back the arena with huge pages, where available
+
+    /** Creates a configuration holding the same values as setDefaultSettings */
+    ALEConfig();
+
+    /** Writes the configuration into the given settings, so that components
+        which read their parameters from Settings see the same values */
+    void apply(Settings& settings) const;
+};
+
+#endif // __ALE_CONFIG_HPP__
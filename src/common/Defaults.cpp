@@ -28,9 +28,23 @@ void setDefaultSettings(Settings &settings) {
 
     // FIFO controller settings
     settings.setBool("run_length_encoding", true);
+    settings.setBool("pipelined_fifo", false);
+
+    // Server controller settings
+    settings.setString("server_socket", "ale_server.sock");
+
+    // Search agent settings
+    settings.setInt("uct_simulations", 500);
+    settings.setInt("uct_depth", 100);
+    settings.setInt("uct_threads", 1);
+    settings.setInt("uct_frame_skip", 4);
+    settings.setFloat("uct_exploration", 0.1);
 
     // Environment customization settings
     settings.setBool("record_trajectory", false);
+    settings.setString("record_dataset", "");
+    settings.setInt("dataset_keyframe_interval", 64);
+    settings.setBool("track_ram_writes", false);
     settings.setBool("restricted_action_set", true);
 
     // Display Settings
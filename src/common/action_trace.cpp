@@ -0,0 +1,147 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  action_trace.cpp
+ *
+ *  The implementation of the ActionTraceWriter and ActionTraceReader classes.
+ **************************************************************************** */
+
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+
+#include "action_trace.h"
+
+static const char TRACE_MAGIC[8] = {'A', 'L', 'E', 'T', 'R', 'C', 'E', '1'};
+
+static void putWord(FILE* file, uInt32 value) {
+    fwrite(&value, sizeof(value), 1, file);
+}
+
+
+ActionTraceWriter::ActionTraceWriter(const string& filename, const string& rom_md5,
+                                     int random_seed, int frame_skip,
+                                     int snapshot_interval):
+    i_snapshot_interval(std::max(snapshot_interval, 1)),
+    i_steps(0),
+    i_since_snapshot(0) {
+
+    p_file = fopen(filename.c_str(), "wb");
+    if (p_file == NULL) {
+        cerr << "Unable to create the action trace " << filename << endl;
+        exit(-1);
+    }
+
+    fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), p_file);
+    putWord(p_file, i_snapshot_interval);
+    putWord(p_file, random_seed);
+    putWord(p_file, frame_skip);
+    putWord(p_file, rom_md5.size());
+    fwrite(rom_md5.data(), 1, rom_md5.size(), p_file);
+}
+
+
+ActionTraceWriter::~ActionTraceWriter() {
+    fclose(p_file);
+}
+
+
+void ActionTraceWriter::addAction(Action action) {
+    assert(action >= 0 && action < TRACE_SNAPSHOT);
+    fputc(action, p_file);
+    i_steps++;
+    i_since_snapshot++;
+}
+
+
+void ActionTraceWriter::addReset() {
+    fputc(TRACE_RESET, p_file);
+    i_steps++;
+    i_since_snapshot++;
+}
+
+
+void ActionTraceWriter::addSnapshot(const string& snapshot) {
+    fputc(TRACE_SNAPSHOT, p_file);
+    putWord(p_file, snapshot.size());
+    fwrite(snapshot.data(), 1, snapshot.size(), p_file);
+    // Everything up to a snapshot can be replayed, even after a crash
+    fflush(p_file);
+    i_since_snapshot = 0;
+}
+
+
+ActionTraceReader::ActionTraceReader(const string& filename):
+    i_random_seed(0), i_frame_skip(0), i_snapshot_interval(0), b_ok(false) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    std::vector<char> data;
+    if (file != NULL) {
+        char buffer[65536];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            data.insert(data.end(), buffer, buffer + n);
+        fclose(file);
+    }
+
+    const int header_size = sizeof(TRACE_MAGIC) + 4 * sizeof(uInt32);
+    if (data.size() < (size_t)header_size ||
+        memcmp(&data[0], TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+        cerr << "Unable to read the action trace " << filename << endl;
+        return;
+    }
+
+    uInt32 header[4];
+    memcpy(header, &data[sizeof(TRACE_MAGIC)], sizeof(header));
+    i_snapshot_interval = header[0];
+    i_random_seed = (Int32)header[1];
+    i_frame_skip = header[2];
+    size_t pos = header_size;
+    size_t md5_length = std::min((size_t)header[3], data.size() - pos);
+    s_rom_md5.assign(&data[pos], md5_length);
+    pos += md5_length;
+
+    // Steps after the last complete snapshot are kept: they are still
+    // valid, as the actions do not depend on what follows
+    while (pos < data.size()) {
+        uInt8 entry = data[pos++];
+        if (entry != TRACE_SNAPSHOT) {
+            v_steps.push_back(entry);
+            continue;
+        }
+
+        uInt32 length;
+        if (data.size() - pos < sizeof(length)) break;
+        memcpy(&length, &data[pos], sizeof(length));
+        pos += sizeof(length);
+        if (data.size() - pos < length) break;
+        v_snapshots.push_back(std::make_pair((int)v_steps.size(),
+                                             string(&data[pos], length)));
+        pos += length;
+    }
+
+    if (v_snapshots.empty()) {
+        cerr << "The action trace " << filename << " has no snapshot" << endl;
+        return;
+    }
+    b_ok = true;
+}
+
+
+const string& ActionTraceReader::snapshotBefore(int n, int& snapshot_step) const {
+    // The snapshots are sorted by step; find the last one at or before n
+    size_t first = 0, last = v_snapshots.size();
+    while (last - first > 1) {
+        size_t middle = (first + last) / 2;
+        if (v_snapshots[middle].first <= n) first = middle;
+        else last = middle;
+    }
+    snapshot_step = v_snapshots[first].first;
+    return v_snapshots[first].second;
+}
@@ -0,0 +1,100 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  action_trace.h
+ *
+ *  The implementation of the ActionTraceWriter and ActionTraceReader classes.
+ *  An action trace stores the actions of a run one byte per step, with a
+ *  snapshot of the whole environment every few steps, so that any step can
+ *  be regenerated by restoring the snapshot before it and replaying at most
+ *  'snapshot interval' actions. The snapshots themselves are opaque here;
+ *  see ALEInterface::saveSnapshot.
+ *
+ *  File layout: "ALETRCE1", u32 snapshot interval, i32 random seed,
+ *  u32 frame skip, u32 length and the ROM's MD5, then one byte per entry:
+ *  an action, TRACE_RESET, or TRACE_SNAPSHOT followed by u32 length and
+ *  the snapshot of the state reached after the entries before it. Values
+ *  are in the host's byte order.
+ **************************************************************************** */
+
+#ifndef ACTION_TRACE_H
+#define ACTION_TRACE_H
+
+#include <cstdio>
+#include <vector>
+#include "Constants.h"
+
+// A step which resets the game rather than taking an action
+#define TRACE_RESET     0xFF
+// Marks a snapshot; not a step
+#define TRACE_SNAPSHOT  0xFE
+
+class ActionTraceWriter {
+    public:
+        // Creates the file; exits if it cannot
+        ActionTraceWriter(const string& filename, const string& rom_md5, int random_seed,
+                          int frame_skip, int snapshot_interval);
+        ~ActionTraceWriter();
+
+        // Appends a step
+        void addAction(Action action);
+        void addReset();
+
+        // Appends a snapshot of the state reached by the steps so far
+        void addSnapshot(const string& snapshot);
+
+        // True once snapshot_interval steps were added since the last snapshot
+        bool needsSnapshot() const { return i_since_snapshot >= i_snapshot_interval; }
+
+        int size() const { return i_steps; }
+
+    protected:
+        FILE* p_file;
+        int i_snapshot_interval;
+        int i_steps;
+        int i_since_snapshot;
+};
+
+class ActionTraceReader {
+    public:
+        // Reads the whole trace. A trace cut short by a crash is read up to
+        // its last complete entry.
+        ActionTraceReader(const string& filename);
+
+        // False if the file could not be read, is not a trace or has no
+        // snapshot; nothing else may be asked of the reader then
+        bool ok() const { return b_ok; }
+
+        const string& romMD5() const { return s_rom_md5; }
+        int randomSeed() const { return i_random_seed; }
+        int frameSkip() const { return i_frame_skip; }
+        int snapshotInterval() const { return i_snapshot_interval; }
+
+        // Number of steps in the trace
+        int size() const { return v_steps.size(); }
+
+        // The action taken at the given step, or TRACE_RESET
+        int step(int n) const { return v_steps[n]; }
+
+        // The latest snapshot of a state at or before step n, i.e. reached
+        // after the first snapshot_step steps
+        const string& snapshotBefore(int n, int& snapshot_step) const;
+
+    protected:
+        string s_rom_md5;
+        int i_random_seed;
+        int i_frame_skip;
+        int i_snapshot_interval;
+        std::vector<uInt8> v_steps;
+        std::vector<std::pair<int, string> > v_snapshots;  // By step
+        bool b_ok;
+};
+
+#endif
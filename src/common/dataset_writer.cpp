@@ -0,0 +1,423 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  dataset_writer.cpp
+ *
+ *  The implementation of the DatasetWriter and DatasetReader classes.
+ **************************************************************************** */
+
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <boost/bind.hpp>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "dataset_writer.h"
+
+using boost::uint64_t;
+
+static const char FILE_MAGIC[8] = {'A', 'L', 'E', 'D', 'S', 'E', 'T', '1'};
+static const char END_MAGIC[8] = {'A', 'L', 'E', 'D', 'S', 'E', 'N', 'D'};
+static const uInt32 CHUNK_MAGIC = 0x4B4E4341;   // "ACNK"
+static const uInt32 INDEX_MAGIC = 0x58444941;   // "AIDX"
+
+static const int FILE_HEADER_SIZE = 8 + 4 * 4;
+static const int CHUNK_HEADER_SIZE = 4 + 4 + 8 + 8;
+static const int RECORD_HEADER_SIZE = 4 + 4 + 4 + 4;   // size, flags, action, reward
+static const int TRAILER_SIZE = 8 + 8;
+
+// Unchanged pixels shorter than this do not end a span of the delta
+static const int MAX_SPAN_GAP = 4;
+
+template <class T>
+static void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static T load(const uInt8* data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+
+DatasetWriter::DatasetWriter(const string& filename, int screen_width,
+                             int screen_height, int keyframe_interval,
+                             int chunk_records, int queue_length):
+    i_frame_size(screen_width * screen_height),
+    i_keyframe_interval(std::max(keyframe_interval, 1)),
+    i_chunk_records(std::max(chunk_records, 1)),
+    i_queue_length(std::max(queue_length, 1)),
+    b_closing(false),
+    p_thread(NULL),
+    i_file_offset(0),
+    v_previous(i_frame_size, 0),
+    i_chunk_count(0),
+    i_records(0),
+    i_since_keyframe(0) {
+
+    p_file = fopen(filename.c_str(), "wb");
+    if (p_file == NULL) {
+        cerr << "Unable to create the dataset file " << filename << endl;
+        exit(-1);
+    }
+
+    std::string header(FILE_MAGIC, sizeof(FILE_MAGIC));
+    append<uInt32>(header, screen_width);
+    append<uInt32>(header, screen_height);
+    append<uInt32>(header, RAM_LENGTH);
+    append<uInt32>(header, i_keyframe_interval);
+    fwrite(header.data(), 1, header.size(), p_file);
+    i_file_offset = header.size();
+
+    for (int i = 0; i < i_queue_length; i++) {
+        Record* record = new Record();
+        record->screen.resize(i_frame_size);
+        v_free.push_back(record);
+    }
+
+    p_thread = new boost::thread(boost::bind(&DatasetWriter::run, this));
+}
+
+
+DatasetWriter::~DatasetWriter() {
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        b_closing = true;
+        m_changed.notify_all();
+    }
+    p_thread->join();
+    delete p_thread;
+
+    flushChunk();
+    writeIndex();
+    fclose(p_file);
+
+    for (size_t i = 0; i < v_free.size(); i++)
+        delete v_free[i];
+}
+
+
+void DatasetWriter::record(const uInt8* screen, const uInt8* ram, Action action,
+                           float reward, int flags) {
+    Record* record;
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        while (v_free.empty())
+            m_changed.wait(lock);
+        record = v_free.back();
+        v_free.pop_back();
+    }
+
+    // The slot belongs to us until it is queued
+    memcpy(&record->screen[0], screen, i_frame_size);
+    memcpy(record->ram, ram, RAM_LENGTH);
+    record->action = action;
+    record->reward = reward;
+    record->flags = flags & (DATASET_TERMINAL | DATASET_EPISODE_START);
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    q_pending.push_back(record);
+    m_changed.notify_all();
+}
+
+
+void DatasetWriter::run() {
+    boost::mutex::scoped_lock lock(m_mutex);
+    while (true) {
+        while (q_pending.empty() && !b_closing)
+            m_changed.wait(lock);
+        if (q_pending.empty()) break;
+
+        Record* record = q_pending.front();
+        q_pending.pop_front();
+
+        lock.unlock();
+        encode(*record);
+        lock.lock();
+
+        v_free.push_back(record);
+        m_changed.notify_all();
+    }
+}
+
+
+void DatasetWriter::encode(const Record& record) {
+    // Chunks and episodes always start with a keyframe, so that either can
+    // be decoded without what came before it
+    bool keyframe = i_chunk_count == 0 || i_since_keyframe >= i_keyframe_interval ||
+                    (record.flags & DATASET_EPISODE_START);
+    const uInt8* screen = &record.screen[0];
+
+    size_t start = s_chunk.size();
+    append<uInt32>(s_chunk, 0);     // Size, filled in below
+    append<uInt8>(s_chunk, record.flags | (keyframe ? DATASET_KEYFRAME : 0));
+    s_chunk.append(3, '\0');
+    append<Int32>(s_chunk, record.action);
+    append<float>(s_chunk, record.reward);
+    s_chunk.append(reinterpret_cast<const char*>(record.ram), RAM_LENGTH);
+
+    if (keyframe) {
+        s_chunk.append(reinterpret_cast<const char*>(screen), i_frame_size);
+        v_chunk_keyframes.push_back(std::make_pair(i_records, (uint64_t)start));
+        i_since_keyframe = 0;
+    }
+    else {
+        // Spans of changed pixels, relative to the end of the previous span
+        int end = 0;
+        int i = 0;
+        while (i < i_frame_size) {
+            if (screen[i] == v_previous[i]) { i++; continue; }
+
+            int first = i;
+            int last = i + 1;
+            for (i = last; i < i_frame_size && i - last < MAX_SPAN_GAP; i++)
+                if (screen[i] != v_previous[i]) last = i + 1;
+            i = last;
+
+            int skip = first - end;
+            while (skip > 0xFFFF) {
+                append<uInt16>(s_chunk, 0xFFFF);
+                append<uInt16>(s_chunk, 0);
+                skip -= 0xFFFF;
+            }
+            while (first < last) {
+                int length = std::min(last - first, 0xFFFF);
+                append<uInt16>(s_chunk, skip);
+                append<uInt16>(s_chunk, length);
+                s_chunk.append(reinterpret_cast<const char*>(screen + first), length);
+                first += length;
+                skip = 0;
+            }
+            end = last;
+        }
+    }
+    i_since_keyframe++;
+
+    uInt32 size = s_chunk.size() - start - sizeof(uInt32);
+    memcpy(&s_chunk[start], &size, sizeof(uInt32));
+    memcpy(&v_previous[0], screen, i_frame_size);
+    i_records++;
+
+    if (++i_chunk_count >= i_chunk_records)
+        flushChunk();
+}
+
+
+void DatasetWriter::flushChunk() {
+    if (i_chunk_count == 0) return;
+
+    std::string header;
+    append<uInt32>(header, CHUNK_MAGIC);
+    append<uInt32>(header, i_chunk_count);
+    append<uint64_t>(header, i_records - i_chunk_count);
+    append<uint64_t>(header, s_chunk.size());
+
+    uint64_t payload = i_file_offset + header.size();
+    for (size_t i = 0; i < v_chunk_keyframes.size(); i++)
+        v_index.push_back(std::make_pair(v_chunk_keyframes[i].first,
+                                         payload + v_chunk_keyframes[i].second));
+
+    fwrite(header.data(), 1, header.size(), p_file);
+    fwrite(s_chunk.data(), 1, s_chunk.size(), p_file);
+    // Whole chunks reach the disk, so a crash loses at most the last one
+    fflush(p_file);
+    i_file_offset += header.size() + s_chunk.size();
+
+    s_chunk.clear();
+    v_chunk_keyframes.clear();
+    i_chunk_count = 0;
+}
+
+
+void DatasetWriter::writeIndex() {
+    std::string index;
+    append<uInt32>(index, INDEX_MAGIC);
+    append<uint64_t>(index, i_records);
+    append<uint64_t>(index, v_index.size());
+    for (size_t i = 0; i < v_index.size(); i++) {
+        append<uint64_t>(index, v_index[i].first);
+        append<uint64_t>(index, v_index[i].second);
+    }
+    append<uint64_t>(index, i_file_offset);
+    index.append(END_MAGIC, sizeof(END_MAGIC));
+
+    fwrite(index.data(), 1, index.size(), p_file);
+    i_file_offset += index.size();
+}
+
+
+DatasetReader::DatasetReader(const string& filename):
+    p_data(NULL),
+    i_size(0),
+    i_records(0),
+    i_current((uint64_t)-1),
+    i_offset(0),
+    i_segment_end(0) {
+
+#ifdef WIN32
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file != NULL) {
+        fseek(file, 0, SEEK_END);
+        v_data.resize(ftell(file));
+        fseek(file, 0, SEEK_SET);
+        if (!v_data.empty() && fread(&v_data[0], 1, v_data.size(), file) == v_data.size())
+            p_data = &v_data[0];
+        fclose(file);
+    }
+    i_size = v_data.size();
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* data = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data != MAP_FAILED) {
+            p_data = static_cast<const uInt8*>(data);
+            i_size = info.st_size;
+        }
+    }
+    if (fd >= 0) close(fd);
+#endif
+
+    if (p_data == NULL || i_size < (uint64_t)FILE_HEADER_SIZE ||
+        memcmp(p_data, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        cerr << "Unable to read the dataset file " << filename << endl;
+        exit(-1);
+    }
+    i_width = load<uInt32>(p_data + 8);
+    i_height = load<uInt32>(p_data + 12);
+    i_ram_size = load<uInt32>(p_data + 16);
+    v_screen.resize(i_width * i_height, 0);
+
+    // Use the index if the file was closed properly, otherwise walk the chunks
+    bool indexed = false;
+    if (i_size >= (uint64_t)(FILE_HEADER_SIZE + TRAILER_SIZE) &&
+        memcmp(p_data + i_size - 8, END_MAGIC, sizeof(END_MAGIC)) == 0) {
+        uint64_t offset = load<uint64_t>(p_data + i_size - TRAILER_SIZE);
+        if (offset + 20 <= i_size - TRAILER_SIZE &&
+            load<uInt32>(p_data + offset) == INDEX_MAGIC) {
+            i_records = load<uint64_t>(p_data + offset + 4);
+            uint64_t n = load<uint64_t>(p_data + offset + 12);
+            if (offset + 20 + n * 16 <= i_size - TRAILER_SIZE) {
+                const uInt8* entry = p_data + offset + 20;
+                for (uint64_t i = 0; i < n; i++, entry += 16)
+                    v_index.push_back(std::make_pair(load<uint64_t>(entry),
+                                                     load<uint64_t>(entry + 8)));
+                indexed = true;
+            }
+        }
+    }
+    if (!indexed) {
+        cerr << "The dataset " << filename << " has no index, rebuilding it" << endl;
+        scanChunks(i_size);
+    }
+}
+
+
+DatasetReader::~DatasetReader() {
+#ifndef WIN32
+    if (p_data != NULL)
+        munmap(const_cast<uInt8*>(p_data), i_size);
+#endif
+}
+
+
+void DatasetReader::scanChunks(uint64_t end) {
+    v_index.clear();
+    i_records = 0;
+
+    uint64_t offset = FILE_HEADER_SIZE;
+    while (offset + CHUNK_HEADER_SIZE <= end &&
+           load<uInt32>(p_data + offset) == CHUNK_MAGIC) {
+        uInt32 count = load<uInt32>(p_data + offset + 4);
+        uint64_t first = load<uint64_t>(p_data + offset + 8);
+        uint64_t payload = load<uint64_t>(p_data + offset + 16);
+        offset += CHUNK_HEADER_SIZE;
+        // A chunk cut short by a crash is dropped
+        if (payload > end - offset) break;
+
+        uint64_t record = offset;
+        for (uInt32 i = 0; i < count; i++) {
+            if (p_data[record + 4] & DATASET_KEYFRAME)
+                v_index.push_back(std::make_pair(first + i, record));
+            record += sizeof(uInt32) + load<uInt32>(p_data + record);
+        }
+        offset += payload;
+        i_records = first + count;
+    }
+}
+
+
+uint64_t DatasetReader::decode(uint64_t offset) {
+    const uInt8* record = p_data + offset;
+    const uInt8* end = record + sizeof(uInt32) + load<uInt32>(record);
+    const uInt8* data = record + RECORD_HEADER_SIZE + i_ram_size;
+
+    if (record[4] & DATASET_KEYFRAME) {
+        memcpy(&v_screen[0], data, v_screen.size());
+    }
+    else {
+        size_t pixel = 0;
+        while (data < end) {
+            pixel += load<uInt16>(data);
+            uInt16 length = load<uInt16>(data + 2);
+            memcpy(&v_screen[pixel], data + 4, length);
+            pixel += length;
+            data += 4 + length;
+        }
+    }
+    return end - p_data;
+}
+
+
+void DatasetReader::read(uint64_t n, uInt8* screen, uInt8* ram, Action& action,
+                         float& reward, int& flags) {
+    assert(n < i_records);
+
+    if (n != i_current) {
+        // Start from the closest keyframe unless n follows the last record
+        // decoded in the same segment
+        uint64_t next;
+        if (i_current == (uint64_t)-1 || n < i_current || n >= i_segment_end) {
+            DatasetIndex::const_iterator it =
+                std::upper_bound(v_index.begin(), v_index.end(),
+                                 std::make_pair(n, (uint64_t)-1));
+            assert(it != v_index.begin());
+            i_segment_end = it == v_index.end() ? i_records : it->first;
+            --it;
+            i_current = it->first;
+            i_offset = it->second;
+            next = decode(i_offset);
+        }
+        else {
+            next = i_offset + sizeof(uInt32) + load<uInt32>(p_data + i_offset);
+        }
+        while (i_current < n) {
+            i_offset = next;
+            next = decode(i_offset);
+            i_current++;
+        }
+    }
+
+    const uInt8* record = p_data + i_offset;
+    flags = record[4];
+    action = (Action)load<Int32>(record + 8);
+    reward = load<float>(record + 12);
+    if (ram != NULL)
+        memcpy(ram, record + RECORD_HEADER_SIZE, std::min(i_ram_size, RAM_LENGTH));
+    if (screen != NULL)
+        memcpy(screen, &v_screen[0], v_screen.size());
+}
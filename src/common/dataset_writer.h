@@ -0,0 +1,151 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  dataset_writer.h
+ *
+ *  The implementation of the DatasetWriter and DatasetReader classes, which
+ *  stream episodes (palette-index screens, RAM, actions, rewards and
+ *  terminal flags) to and from one append-only, memory-mappable file.
+ *
+ *  File layout, all values in the host's byte order:
+ *
+ *    header    "ALEDSET1", u32 width, u32 height, u32 ram size,
+ *              u32 keyframe interval
+ *    chunk*    u32 'ACNK', u32 number of records, u64 first record,
+ *              u64 payload bytes, then the records
+ *    index     u32 'AIDX', u64 number of records, u64 n,
+ *              n x {u64 record, u64 file offset} of every keyframe
+ *    trailer   u64 offset of the index, "ALEDSEND"
+ *
+ *  A record is u32 size (of what follows), u8 flags, 3 bytes padding,
+ *  i32 action, f32 reward, the RAM, then the screen: raw for a keyframe,
+ *  otherwise the spans which changed since the previous record, each as
+ *  u16 pixels skipped, u16 length and the pixels. Every chunk starts with a
+ *  keyframe, as does every episode, so both can be decoded on their own
+ *  without reading what came before; a file without its index
+ *  (e.g. after a crash) can be recovered by walking the chunks.
+ **************************************************************************** */
+
+#ifndef DATASET_WRITER_H
+#define DATASET_WRITER_H
+
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/thread.hpp>
+#include "Constants.h"
+
+// Keyframe record number -> its offset
+typedef std::vector<std::pair<boost::uint64_t, boost::uint64_t> > DatasetIndex;
+
+// Record flags
+#define DATASET_TERMINAL        0x01    // The game ended with this record
+#define DATASET_EPISODE_START   0x02    // First record of an episode (after a reset)
+#define DATASET_KEYFRAME        0x04    // The screen is stored in full
+
+class DatasetWriter {
+    public:
+        // Creates the file. Records are encoded and written by a background
+        // thread; at most queue_length of them wait in memory.
+        DatasetWriter(const string& filename, int screen_width, int screen_height,
+                      int keyframe_interval = 64, int chunk_records = 1024,
+                      int queue_length = 16);
+
+        // Writes the pending records and the index, and closes the file
+        ~DatasetWriter();
+
+        // Queues one record: the screen and RAM reached by taking 'action',
+        // and the reward it gave. Blocks if the writer has fallen behind.
+        void record(const uInt8* screen, const uInt8* ram, Action action,
+                    float reward, int flags);
+
+    protected:
+        struct Record {
+            std::vector<uInt8> screen;
+            uInt8 ram[RAM_LENGTH];
+            Int32 action;
+            float reward;
+            int flags;
+        };
+
+        void run();
+        void encode(const Record& record);
+        void flushChunk();
+        void writeIndex();
+
+    protected:
+        FILE* p_file;
+        int i_frame_size;
+        int i_keyframe_interval;
+        int i_chunk_records;
+        int i_queue_length;
+
+        // Shared with the writer thread
+        boost::mutex m_mutex;
+        boost::condition_variable m_changed;
+        std::deque<Record*> q_pending;   // Filled records, oldest first
+        std::vector<Record*> v_free;     // Preallocated records to fill
+        bool b_closing;
+        boost::thread* p_thread;
+
+        // Writer thread only
+        boost::uint64_t i_file_offset;   // Bytes written to the file
+        std::vector<uInt8> v_previous;   // Screen of the last record written
+        std::string s_chunk;             // Payload of the chunk being built
+        int i_chunk_count;               // Records in s_chunk
+        boost::uint64_t i_records;       // Records written so far
+        int i_since_keyframe;            // Records since the last keyframe
+        DatasetIndex v_index;            // Keyframes of the chunks written
+        DatasetIndex v_chunk_keyframes;  // Keyframes in s_chunk, by offset in it
+};
+
+class DatasetReader {
+    public:
+        // Maps the file; exits if it is not a dataset
+        DatasetReader(const string& filename);
+        ~DatasetReader();
+
+        int screenWidth() const { return i_width; }
+        int screenHeight() const { return i_height; }
+        boost::uint64_t size() const { return i_records; }
+
+        // Decodes record n. screen must hold width * height bytes and ram
+        // RAM_LENGTH bytes; either may be NULL. Reading records in order
+        // only decodes each one once.
+        void read(boost::uint64_t n, uInt8* screen, uInt8* ram, Action& action,
+                  float& reward, int& flags);
+
+    protected:
+        // Rebuilds the index by walking the chunks (file without trailer)
+        void scanChunks(boost::uint64_t end);
+
+        // Decodes the screen of the record at 'offset' on top of v_screen
+        // and returns the offset of the next record
+        boost::uint64_t decode(boost::uint64_t offset);
+
+    protected:
+        const uInt8* p_data;
+        boost::uint64_t i_size;
+#ifdef WIN32
+        std::vector<uInt8> v_data;
+#endif
+        int i_width, i_height, i_ram_size;
+        boost::uint64_t i_records;
+        DatasetIndex v_index;
+
+        // The last record decoded, whose screen is in v_screen
+        std::vector<uInt8> v_screen;
+        boost::uint64_t i_current;       // Its number, or -1
+        boost::uint64_t i_offset;        // Its offset
+        boost::uint64_t i_segment_end;   // Number of the next keyframe
+};
+
+#endif
@@ -7,6 +7,13 @@ MODULE_OBJS := \
 	src/common/visual_processor.o \
 	src/common/Constants.o \
 	src/common/Defaults.o \
+	src/common/ALEConfig.o \
+	src/common/screen_preprocessor.o \
+	src/common/observation_history.o \
+	src/common/dataset_writer.o \
+	src/common/screen_exporter.o \
+	src/common/action_trace.o \
+	src/common/state_blob.o \
 
 MODULE_DIRS += \
 	src/common
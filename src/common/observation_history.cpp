@@ -0,0 +1,65 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  observation_history.cpp
+ *
+ *  The implementation of the ObservationHistory class.
+ **************************************************************************** */
+
+#include <cstring>
+
+#include "observation_history.h"
+
+void StackedObservation::copyTo(uInt8* out) const {
+    for (int i = 0; i < i_count; i++, out += i_frame_size)
+        memcpy(out, (*this)[i], i_frame_size);
+}
+
+
+ObservationHistory::ObservationHistory(int frame_size, int capacity):
+    i_frame_size(frame_size),
+    i_capacity(capacity),
+    v_frames(frame_size * capacity, 0),
+    i_next(0),
+    i_size(0) {
+    assert(frame_size > 0 && capacity > 0);
+}
+
+
+void ObservationHistory::commit() {
+    i_next = (i_next + 1) % i_capacity;
+    if (i_size < i_capacity) i_size++;
+}
+
+
+void ObservationHistory::push(const uInt8* frame) {
+    memcpy(nextFrame(), frame, i_frame_size);
+    commit();
+}
+
+
+const uInt8* ObservationHistory::frame(int age) const {
+    assert(age >= 0 && age < i_size);
+    int slot = (i_next - 1 - age + 2 * i_capacity) % i_capacity;
+    return &v_frames[slot * i_frame_size];
+}
+
+
+StackedObservation ObservationHistory::getStackedObservation(int k) const {
+    assert(k > 0 && k <= i_capacity && i_size > 0);
+    StackedObservation stack;
+    stack.p_base = &v_frames[0];
+    stack.i_frame_size = i_frame_size;
+    stack.i_capacity = i_capacity;
+    stack.i_newest = (i_next - 1 + i_capacity) % i_capacity;
+    stack.i_count = k;
+    stack.i_available = i_size;
+    return stack;
+}
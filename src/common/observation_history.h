@@ -0,0 +1,94 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  observation_history.h
+ *
+ *  The implementation of the ObservationHistory class, a fixed ring of the
+ *  most recent uint8 frames kept in one contiguous allocation. Stacks of the
+ *  last k frames are handed out as views into the ring, without copying.
+ **************************************************************************** */
+
+#ifndef OBSERVATION_HISTORY_H
+#define OBSERVATION_HISTORY_H
+
+#include <vector>
+#include "Constants.h"
+
+/**
+   A view of the last k frames of an ObservationHistory, oldest first. The
+   frames are not copied, so the view is only valid until the next frame is
+   added to the history.
+ */
+class StackedObservation {
+    public:
+        StackedObservation(): p_base(NULL), i_frame_size(0), i_capacity(0),
+                              i_newest(0), i_count(0), i_available(0) {}
+
+        int size() const { return i_count; }
+        int frameSize() const { return i_frame_size; }
+
+        // Frame i of the stack; 0 is the oldest. While the history holds fewer
+        // than size() frames, the oldest one it has is repeated.
+        const uInt8* operator[](int i) const {
+            int age = i_count - 1 - i;
+            if (age >= i_available) age = i_available - 1;
+            int slot = (i_newest - age + i_capacity) % i_capacity;
+            return p_base + slot * i_frame_size;
+        }
+
+        // Copies the stack into out (size() * frameSize() bytes)
+        void copyTo(uInt8* out) const;
+
+    protected:
+        friend class ObservationHistory;
+
+        const uInt8* p_base;    // Start of the ring
+        int i_frame_size;
+        int i_capacity;         // Number of slots in the ring
+        int i_newest;           // Slot of the most recent frame
+        int i_count;            // Frames in the stack
+        int i_available;        // Frames held by the history
+};
+
+class ObservationHistory {
+    public:
+        ObservationHistory(int frame_size, int capacity);
+
+        int frameSize() const { return i_frame_size; }
+        int capacity() const { return i_capacity; }
+        // Number of frames held, at most capacity()
+        int size() const { return i_size; }
+
+        // Forgets every frame
+        void clear() { i_size = 0; }
+
+        // Slot the next frame should be written into; it is only added to the
+        // history by commit(), so producers can write into it directly
+        uInt8* nextFrame() { return &v_frames[i_next * i_frame_size]; }
+        void commit();
+
+        // Copies a frame into the history, dropping the oldest one if full
+        void push(const uInt8* frame);
+
+        // The frame added 'age' frames ago; 0 is the most recent
+        const uInt8* frame(int age = 0) const;
+
+        // Views of the last k frames, oldest first; k must not exceed capacity()
+        StackedObservation getStackedObservation(int k) const;
+
+    protected:
+        int i_frame_size;
+        int i_capacity;
+        std::vector<uInt8> v_frames;  // capacity * frame_size bytes
+        int i_next;                   // Slot of the next frame
+        int i_size;
+};
+
+#endif
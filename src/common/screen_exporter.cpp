@@ -0,0 +1,363 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  screen_exporter.cpp
+ *
+ *  The implementation of the ScreenExporter class.
+ **************************************************************************** */
+
+#include <zlib.h>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <boost/bind.hpp>
+
+#include "screen_exporter.h"
+#include "export_screen.h"
+
+/* An animated PNG being written; only touched with its mutex held */
+class ExportVideo {
+    public:
+        FILE* p_file;
+        string s_filename;
+        int i_fps;
+        int i_frames_queued;        // Frames given to addFrame
+        int i_next_frame;           // Next frame to write
+        std::map<int, void*> m_ready; // Compressed frames waiting for earlier ones
+        boost::mutex m_mutex;
+};
+
+
+static void putWord(uInt8* out, uInt32 value) {
+    out[0] = value >> 24;
+    out[1] = value >> 16;
+    out[2] = value >> 8;
+    out[3] = value;
+}
+
+static void putHalf(uInt8* out, uInt16 value) {
+    out[0] = value >> 8;
+    out[1] = value;
+}
+
+static void writeChunk(FILE* out, const char* type, const uInt8* data, uInt32 size) {
+    uInt8 temp[8];
+    putWord(temp, size);
+    memcpy(temp + 4, type, 4);
+    fwrite(temp, 1, 8, out);
+
+    uInt32 crc = crc32(0, temp + 4, 4);
+    if (size > 0) {
+        fwrite(data, 1, size, out);
+        crc = crc32(crc, data, size);
+    }
+    putWord(temp, crc);
+    fwrite(temp, 1, 4, out);
+}
+
+static const uInt8 PNG_SIGNATURE[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+// Offset of the acTL chunk, right after the signature and IHDR
+static const int ACTL_OFFSET = 8 + 8 + 13 + 4;
+
+
+ScreenExporter::ScreenExporter(const ExportScreen& palette, int screen_width,
+                               int screen_height, int num_threads, int pool_size,
+                               int compression_level):
+    i_screen_width(screen_width),
+    i_screen_height(screen_height),
+    i_compression_level(compression_level),
+    v_plte(256 * 3),
+    i_pool_size(std::max(pool_size, 1)),
+    b_closing(false) {
+
+    for (int c = 0; c < 256; c++) {
+        int r, g, b;
+        palette.get_rgb_from_palette(c, r, g, b);
+        v_plte[c * 3 + 0] = r;
+        v_plte[c * 3 + 1] = g;
+        v_plte[c * 3 + 2] = b;
+    }
+
+    for (int i = 0; i < i_pool_size; i++) {
+        Job* job = new Job();
+        job->pixels.resize(screen_width * screen_height);
+        job->compressed.resize(compressBound(screen_height * (screen_width + 1)));
+        v_free.push_back(job);
+    }
+
+    for (int i = 0; i < std::max(num_threads, 1); i++)
+        m_threads.create_thread(boost::bind(&ScreenExporter::run, this));
+}
+
+
+ScreenExporter::~ScreenExporter() {
+    // Videos still open are ended after their queued frames
+    std::vector<ExportVideo*> videos;
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        videos = v_open_videos;
+    }
+    for (size_t i = 0; i < videos.size(); i++)
+        endVideo(videos[i]);
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        b_closing = true;
+        m_changed.notify_all();
+    }
+    m_threads.join_all();
+
+    for (size_t i = 0; i < v_free.size(); i++)
+        delete v_free[i];
+}
+
+
+ScreenExporter::Job* ScreenExporter::acquire() {
+    boost::mutex::scoped_lock lock(m_mutex);
+    while (v_free.empty())
+        m_changed.wait(lock);
+    Job* job = v_free.back();
+    v_free.pop_back();
+    job->video = NULL;
+    job->end_of_video = false;
+    return job;
+}
+
+
+void ScreenExporter::release(Job* job) {
+    boost::mutex::scoped_lock lock(m_mutex);
+    v_free.push_back(job);
+    m_changed.notify_all();
+}
+
+
+void ScreenExporter::enqueue(Job* job) {
+    boost::mutex::scoped_lock lock(m_mutex);
+    q_pending.push_back(job);
+    m_changed.notify_all();
+}
+
+
+void ScreenExporter::flush() {
+    boost::mutex::scoped_lock lock(m_mutex);
+    while ((int)v_free.size() < i_pool_size)
+        m_changed.wait(lock);
+}
+
+
+void ScreenExporter::savePNG(const uInt8* frame_buffer, const string& filename) {
+    Job* job = acquire();
+    memcpy(&job->pixels[0], frame_buffer, job->pixels.size());
+    job->filename = filename;
+    enqueue(job);
+}
+
+
+ExportVideo* ScreenExporter::beginVideo(const string& filename, int frames_per_second) {
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        cerr << "Couldn't open video file " << filename << endl;
+        return NULL;
+    }
+
+    ExportVideo* video = new ExportVideo();
+    video->p_file = file;
+    video->s_filename = filename;
+    video->i_fps = std::max(frames_per_second, 1);
+    video->i_frames_queued = 0;
+    video->i_next_frame = 0;
+    // The frame count is not known yet; it is filled in by the end
+    writeHeader(file, 0);
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    v_open_videos.push_back(video);
+    return video;
+}
+
+
+void ScreenExporter::addFrame(ExportVideo* video, const uInt8* frame_buffer) {
+    if (video == NULL) return;
+
+    Job* job = acquire();
+    memcpy(&job->pixels[0], frame_buffer, job->pixels.size());
+    job->video = video;
+    job->frame = video->i_frames_queued++;
+    enqueue(job);
+}
+
+
+void ScreenExporter::endVideo(ExportVideo* video) {
+    if (video == NULL) return;
+
+    Job* job = acquire();
+    job->video = video;
+    job->frame = video->i_frames_queued;
+    job->end_of_video = true;
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    v_open_videos.erase(std::remove(v_open_videos.begin(), v_open_videos.end(), video),
+                        v_open_videos.end());
+    q_pending.push_back(job);
+    m_changed.notify_all();
+}
+
+
+void ScreenExporter::run() {
+    std::vector<uInt8> scanlines(i_screen_height * (i_screen_width + 1));
+
+    while (true) {
+        Job* job;
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            while (q_pending.empty() && !b_closing)
+                m_changed.wait(lock);
+            if (q_pending.empty()) return;
+            job = q_pending.front();
+            q_pending.pop_front();
+        }
+
+        if (!job->end_of_video)
+            compress(job, scanlines);
+
+        if (job->video != NULL) {
+            writeVideo(job);
+        }
+        else {
+            writePNG(job);
+            release(job);
+        }
+    }
+}
+
+
+void ScreenExporter::compress(Job* job, std::vector<uInt8>& scanlines) {
+    // Every row starts with its filter type, 0 (none)
+    uInt8* row = &scanlines[0];
+    const uInt8* pixels = &job->pixels[0];
+    for (int i = 0; i < i_screen_height; i++) {
+        *row++ = 0;
+        memcpy(row, pixels, i_screen_width);
+        row += i_screen_width;
+        pixels += i_screen_width;
+    }
+
+    uLongf size = job->compressed.capacity();
+    job->compressed.resize(size);
+    if (compress2(&job->compressed[0], &size, &scanlines[0], scanlines.size(),
+                  i_compression_level) != Z_OK) {
+        cerr << "Error: Couldn't compress PNG" << endl;
+        size = 0;
+    }
+    job->compressed.resize(size);
+}
+
+
+void ScreenExporter::writeHeader(FILE* out, int num_frames) const {
+    fwrite(PNG_SIGNATURE, 1, 8, out);
+
+    uInt8 ihdr[13];
+    putWord(ihdr, i_screen_width);
+    putWord(ihdr + 4, i_screen_height);
+    ihdr[8]  = 8;  // 8 bits per palette index
+    ihdr[9]  = 3;  // PNG_COLOR_TYPE_PALETTE
+    ihdr[10] = 0;  // PNG_COMPRESSION_TYPE_DEFAULT
+    ihdr[11] = 0;  // PNG_FILTER_TYPE_DEFAULT
+    ihdr[12] = 0;  // PNG_INTERLACE_NONE
+    writeChunk(out, "IHDR", ihdr, 13);
+
+    if (num_frames >= 0) {
+        uInt8 actl[8];
+        putWord(actl, num_frames);
+        putWord(actl + 4, 0);   // Loop forever
+        writeChunk(out, "acTL", actl, 8);
+    }
+    writeChunk(out, "PLTE", &v_plte[0], v_plte.size());
+}
+
+
+void ScreenExporter::writePNG(const Job* job) {
+    FILE* out = fopen(job->filename.c_str(), "wb");
+    if (out == NULL) {
+        cerr << "Couldn't open PNG file " << job->filename << endl;
+        return;
+    }
+    writeHeader(out, -1);
+    writeChunk(out, "IDAT", &job->compressed[0], job->compressed.size());
+    writeChunk(out, "IEND", NULL, 0);
+    fclose(out);
+}
+
+
+void ScreenExporter::writeVideo(Job* job) {
+    ExportVideo* video = job->video;
+    std::vector<Job*> done;
+    bool finished = false;
+    {
+        boost::mutex::scoped_lock lock(video->m_mutex);
+        video->m_ready[job->frame] = job;
+
+        // Frames may finish out of order with several threads; only the
+        // thread completing the next frame writes, and takes the ones after
+        std::map<int, void*>::iterator it;
+        while ((it = video->m_ready.find(video->i_next_frame)) != video->m_ready.end()) {
+            Job* next = static_cast<Job*>(it->second);
+            video->m_ready.erase(it);
+            done.push_back(next);
+
+            if (next->end_of_video) {
+                writeChunk(video->p_file, "IEND", NULL, 0);
+                // Now that the frame count is known, fix the acTL chunk
+                fseek(video->p_file, ACTL_OFFSET, SEEK_SET);
+                uInt8 actl[8];
+                putWord(actl, video->i_next_frame);
+                putWord(actl + 4, 0);
+                writeChunk(video->p_file, "acTL", actl, 8);
+                fclose(video->p_file);
+                finished = true;
+                break;
+            }
+
+            // Frame n has sequence numbers 2n - 1 (fcTL) and 2n (fdAT);
+            // the first frame is stored in IDAT, which has none
+            int n = video->i_next_frame;
+            uInt8 fctl[26];
+            putWord(fctl, n == 0 ? 0 : 2 * n - 1);
+            putWord(fctl + 4, i_screen_width);
+            putWord(fctl + 8, i_screen_height);
+            putWord(fctl + 12, 0);          // x offset
+            putWord(fctl + 16, 0);          // y offset
+            putHalf(fctl + 20, 1);          // delay numerator
+            putHalf(fctl + 22, video->i_fps); // delay denominator
+            fctl[24] = 0;                   // APNG_DISPOSE_OP_NONE
+            fctl[25] = 0;                   // APNG_BLEND_OP_SOURCE
+            writeChunk(video->p_file, "fcTL", fctl, 26);
+
+            if (n == 0) {
+                writeChunk(video->p_file, "IDAT", &next->compressed[0],
+                           next->compressed.size());
+            }
+            else {
+                // fdAT is the sequence number followed by the IDAT data
+                next->compressed.insert(next->compressed.begin(), 4, 0);
+                putWord(&next->compressed[0], 2 * n);
+                writeChunk(video->p_file, "fdAT", &next->compressed[0],
+                           next->compressed.size());
+            }
+            video->i_next_frame++;
+        }
+    }
+
+    if (finished) delete video;
+    // If the job was not written, it stays out of the pool until the
+    // thread completing the frame before it gets to it
+    for (size_t i = 0; i < done.size(); i++)
+        release(done[i]);
+}
@@ -0,0 +1,98 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  screen_exporter.h
+ *
+ *  The implementation of the ScreenExporter class, which saves screens as
+ *  PNG files, or whole episodes as one animated PNG, from background
+ *  threads. Frames are stored as palette indices with the Atari palette in
+ *  the PNG, so no colour conversion is needed, and are copied into a fixed
+ *  pool of buffers; the caller only waits when the pool is exhausted.
+ **************************************************************************** */
+
+#ifndef SCREEN_EXPORTER_H
+#define SCREEN_EXPORTER_H
+
+#include <deque>
+#include <map>
+#include <vector>
+#include <boost/thread.hpp>
+#include "Constants.h"
+
+class ExportScreen;
+class ExportVideo;
+
+class ScreenExporter {
+    public:
+        // compression_level is zlib's, from 1 (fastest) to 9 (smallest)
+        ScreenExporter(const ExportScreen& palette, int screen_width, int screen_height,
+                       int num_threads = 1, int pool_size = 32,
+                       int compression_level = 1);
+
+        // Finishes every queued frame, and the videos not ended yet
+        ~ScreenExporter();
+
+        // Queues the given frame buffer to be saved as a PNG file
+        void savePNG(const uInt8* frame_buffer, const string& filename);
+
+        // Starts an animated PNG played at the given rate. The video must be
+        // given to endVideo once its last frame has been added.
+        ExportVideo* beginVideo(const string& filename, int frames_per_second = 60);
+
+        // Queues the given frame buffer as the next frame of the video
+        void addFrame(ExportVideo* video, const uInt8* frame_buffer);
+
+        // Queues the end of the video; it is closed once its frames are
+        // written, after which the pointer must no longer be used
+        void endVideo(ExportVideo* video);
+
+        // Waits until everything queued so far is on disk
+        void flush();
+
+    protected:
+        struct Job {
+            std::vector<uInt8> pixels;       // Frame buffer copy
+            std::vector<uInt8> compressed;   // Its zlib stream, once compressed
+            string filename;                 // PNG file, if not a video frame
+            ExportVideo* video;
+            int frame;                       // Frame number in the video
+            bool end_of_video;               // Closes the video; carries no pixels
+        };
+
+        Job* acquire();
+        void release(Job* job);
+        void enqueue(Job* job);
+
+        void run();
+        void compress(Job* job, std::vector<uInt8>& scanlines);
+        void writePNG(const Job* job);
+
+        // Writes the frames of the video which are ready, in order
+        void writeVideo(Job* job);
+
+        void writeHeader(FILE* out, int num_frames) const;
+
+    protected:
+        int i_screen_width;
+        int i_screen_height;
+        int i_compression_level;
+        std::vector<uInt8> v_plte;           // The PLTE chunk data
+
+        boost::mutex m_mutex;
+        boost::condition_variable m_changed;
+        std::deque<Job*> q_pending;
+        std::vector<Job*> v_free;
+        int i_pool_size;
+        bool b_closing;
+        std::vector<ExportVideo*> v_open_videos;
+        boost::thread_group m_threads;
+};
+
+#endif
@@ -0,0 +1,205 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  screen_preprocessor.cpp
+ *
+ *  The implementation of the ScreenPreprocessor class.
+ **************************************************************************** */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "screen_preprocessor.h"
+#include "export_screen.h"
+
+PreprocessConfig::PreprocessConfig():
+    crop_top(0), crop_bottom(0),
+    crop_left(0), crop_right(0),
+    output_width(84), output_height(84),
+    resize_mode(RESIZE_AREA),
+    max_pool(true),
+    frame_stack(4) {
+}
+
+
+/* stores the per-pixel maximum of a and b in a */
+static void maxBytes(uInt8* a, const uInt8* b, int n) {
+    int i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        _mm_storeu_si128((__m128i*)(a + i), _mm_max_epu8(va, vb));
+    }
+#endif
+    for (; i < n; i++)
+        if (b[i] > a[i]) a[i] = b[i];
+}
+
+
+ScreenPreprocessor::ScreenPreprocessor(const PreprocessConfig& config, int screen_width,
+                                       int screen_height, const ExportScreen& palette):
+    m_config(config),
+    i_screen_width(screen_width),
+    m_stack(std::max(config.output_width * config.output_height, 1),
+            std::max(config.frame_stack, 1)) {
+
+    i_crop_width = screen_width - config.crop_left - config.crop_right;
+    i_crop_height = screen_height - config.crop_top - config.crop_bottom;
+    if (i_crop_width <= 0 || i_crop_height <= 0 || config.crop_left < 0 ||
+        config.crop_right < 0 || config.crop_top < 0 || config.crop_bottom < 0) {
+        cerr << "A.L.E: invalid crop for a " << screen_width << "x"
+             << screen_height << " screen" << endl;
+        exit(1);
+    }
+    if (config.output_width <= 0 || config.output_height <= 0 || config.frame_stack <= 0) {
+        cerr << "A.L.E: invalid preprocessing output size" << endl;
+        exit(1);
+    }
+
+    // ITU-R 601 luma, as used by most Atari agents
+    for (int c = 0; c < 256; c++) {
+        int r, g, b;
+        palette.get_rgb_from_palette(c, r, g, b);
+        pi_luminance[c] = (uInt8)(0.299 * r + 0.587 * g + 0.114 * b + 0.5);
+    }
+
+    buildTaps(i_crop_height, config.output_height, v_row_taps);
+    buildTaps(i_crop_width, config.output_width, v_col_taps);
+
+    v_gray.resize(i_crop_width * i_crop_height);
+    v_gray_previous.resize(i_crop_width * i_crop_height);
+    v_columns.resize(i_crop_height * config.output_width);
+    v_row.resize(config.output_width);
+}
+
+
+/* computes which source pixels make up each output pixel along one axis */
+void ScreenPreprocessor::buildTaps(int in_size, int out_size, std::vector<Taps>& taps) const {
+    double scale = (double)in_size / out_size;
+    taps.resize(out_size);
+
+    for (int o = 0; o < out_size; o++) {
+        Taps& t = taps[o];
+        t.weights.clear();
+
+        if (m_config.resize_mode == RESIZE_AREA) {
+            // Weight each source pixel by how much of [start, end) it covers
+            double start = o * scale, end = (o + 1) * scale;
+            t.first = (int)floor(start);
+            for (int i = t.first; i < end && i < in_size; i++) {
+                double covered = std::min(end, i + 1.0) - std::max(start, (double)i);
+                t.weights.push_back((float)(covered / scale));
+            }
+        } else {
+            // Pixel centres are aligned, as in most image libraries
+            double src = (o + 0.5) * scale - 0.5;
+            if (src < 0) src = 0;
+            int i0 = (int)floor(src);
+            if (i0 >= in_size - 1) {
+                t.first = in_size - 1;
+                t.weights.push_back(1.0f);
+            } else {
+                float frac = (float)(src - i0);
+                t.first = i0;
+                t.weights.push_back(1.0f - frac);
+                t.weights.push_back(frac);
+            }
+        }
+    }
+}
+
+
+/* converts the cropped screen to luminance, max pooling if enabled */
+void ScreenPreprocessor::toGray(const uInt8* current, const uInt8* previous) {
+    const uInt8* src = current + m_config.crop_top * i_screen_width + m_config.crop_left;
+    uInt8* dst = &v_gray[0];
+    for (int y = 0; y < i_crop_height; y++, src += i_screen_width, dst += i_crop_width)
+        for (int x = 0; x < i_crop_width; x++)
+            dst[x] = pi_luminance[src[x]];
+
+    if (!m_config.max_pool || previous == NULL) return;
+
+    src = previous + m_config.crop_top * i_screen_width + m_config.crop_left;
+    dst = &v_gray_previous[0];
+    for (int y = 0; y < i_crop_height; y++, src += i_screen_width, dst += i_crop_width)
+        for (int x = 0; x < i_crop_width; x++)
+            dst[x] = pi_luminance[src[x]];
+
+    maxBytes(&v_gray[0], &v_gray_previous[0], i_crop_width * i_crop_height);
+}
+
+
+void ScreenPreprocessor::process(const uInt8* current, const uInt8* previous, uInt8* out) {
+    toGray(current, previous);
+
+    int out_w = m_config.output_width;
+    int out_h = m_config.output_height;
+
+    // Horizontal pass: every cropped row to out_w columns
+    for (int y = 0; y < i_crop_height; y++) {
+        const uInt8* src = &v_gray[y * i_crop_width];
+        float* dst = &v_columns[y * out_w];
+        for (int x = 0; x < out_w; x++) {
+            const Taps& t = v_col_taps[x];
+            float sum = 0;
+            for (size_t k = 0; k < t.weights.size(); k++)
+                sum += t.weights[k] * src[t.first + k];
+            dst[x] = sum;
+        }
+    }
+
+    // Vertical pass: whole rows at a time, so the inner loop is contiguous
+    for (int y = 0; y < out_h; y++) {
+        const Taps& t = v_row_taps[y];
+        float* row = &v_row[0];
+        for (int x = 0; x < out_w; x++) row[x] = 0;
+
+        for (size_t k = 0; k < t.weights.size(); k++) {
+            const float* src = &v_columns[(t.first + k) * out_w];
+            float w = t.weights[k];
+            for (int x = 0; x < out_w; x++)
+                row[x] += w * src[x];
+        }
+
+        uInt8* dst = out + y * out_w;
+        for (int x = 0; x < out_w; x++) {
+            float v = row[x] + 0.5f;
+            dst[x] = v >= 255.0f ? 255 : (uInt8)v;
+        }
+    }
+}
+
+
+void ScreenPreprocessor::push(const uInt8* current, const uInt8* previous) {
+    process(current, previous, m_stack.nextFrame());
+    m_stack.commit();
+}
+
+
+void ScreenPreprocessor::fill(const uInt8* current, const uInt8* previous) {
+    // A stack holding one frame repeats it in every position
+    m_stack.clear();
+    push(current, previous);
+}
+
+
+void ScreenPreprocessor::copyStack(uInt8* out) const {
+    getStack(m_config.frame_stack).copyTo(out);
+}
+
+
+StackedObservation ScreenPreprocessor::getStack(int k) const {
+    return m_stack.getStackedObservation(k);
+}
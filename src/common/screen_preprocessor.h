@@ -0,0 +1,103 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  screen_preprocessor.h
+ *
+ *  The implementation of the ScreenPreprocessor class, which turns the
+ *  palette-indexed screen into the small grayscale frames most learning
+ *  agents train on: luminance, max over the last two frames, crop, resize
+ *  and a stack of the most recent frames.
+ **************************************************************************** */
+
+#ifndef SCREEN_PREPROCESSOR_H
+#define SCREEN_PREPROCESSOR_H
+
+#include <vector>
+#include "Constants.h"
+#include "observation_history.h"
+
+class ExportScreen;
+
+enum ResizeMode {
+    RESIZE_AREA,            // Average of the covered source pixels
+    RESIZE_BILINEAR         // Interpolation between the nearest source pixels
+};
+
+struct PreprocessConfig {
+    int crop_top, crop_bottom;   // Screen rows removed before resizing
+    int crop_left, crop_right;   // Screen columns removed before resizing
+    int output_width, output_height;
+    ResizeMode resize_mode;
+    bool max_pool;               // Take the max of the current and previous frames,
+                                 //  which removes sprite flicker
+    int frame_stack;             // Number of frames kept in the stack
+
+    /** The usual DQN setting: 84x84, area resize, max pooling, 4 frames */
+    PreprocessConfig();
+};
+
+class ScreenPreprocessor {
+    public:
+        ScreenPreprocessor(const PreprocessConfig& config, int screen_width,
+                           int screen_height, const ExportScreen& palette);
+
+        const PreprocessConfig& config() const { return m_config; }
+
+        // Number of bytes of one processed frame, and of the whole stack
+        int frameSize() const { return m_config.output_width * m_config.output_height; }
+        int stackSize() const { return frameSize() * m_config.frame_stack; }
+
+        // Processes the given frame buffers into out (frameSize() bytes).
+        // previous is only read when max pooling.
+        void process(const uInt8* current, const uInt8* previous, uInt8* out);
+
+        // Processes the given frame buffers and adds the result to the
+        // stack, dropping the oldest frame
+        void push(const uInt8* current, const uInt8* previous);
+
+        // Fills the whole stack with the given frame; used after a reset
+        void fill(const uInt8* current, const uInt8* previous);
+
+        // Copies the stack into out (stackSize() bytes), oldest frame first
+        void copyStack(uInt8* out) const;
+
+        // Views of the last k stacked frames (at most frame_stack), oldest
+        // first, valid until the next push
+        StackedObservation getStack(int k) const;
+
+    protected:
+        // Source pixels contributing to one output pixel along one axis
+        struct Taps {
+            int first;               // First source index
+            std::vector<float> weights;
+        };
+
+        void buildTaps(int in_size, int out_size, std::vector<Taps>& taps) const;
+
+        // Writes the luminance of the cropped screen into m_gray
+        void toGray(const uInt8* current, const uInt8* previous);
+
+    protected:
+        PreprocessConfig m_config;
+        int i_screen_width;
+        int i_crop_width, i_crop_height;
+
+        uInt8 pi_luminance[256];         // Palette index -> luminance
+        std::vector<Taps> v_row_taps, v_col_taps;
+
+        std::vector<uInt8> v_gray;       // Cropped luminance frame
+        std::vector<uInt8> v_gray_previous;
+        std::vector<float> v_columns;    // Cropped rows resized horizontally
+        std::vector<float> v_row;        // One output row being accumulated
+
+        ObservationHistory m_stack;      // The last frame_stack frames
+};
+
+#endif
@@ -0,0 +1,149 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  state_blob.cpp
+ *
+ *  The implementation of the portable state blob framing.
+ **************************************************************************** */
+
+#include <cstring>
+#include <iostream>
+#include <zlib.h>
+
+#include "state_blob.h"
+
+static const char BLOB_MAGIC[4] = {'A', 'L', 'E', 'B'};
+static const size_t BLOB_HEADER_SIZE = 4 + 4 + 16 + 3 * 4;
+// Larger sizes can only come from damaged data; an emulator state is a few KB
+static const uInt32 BLOB_MAX_SIZE = 1 << 24;
+
+static void putWord(uInt8* out, uInt32 value) {
+    for (int i = 0; i < 4; i++)
+        out[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static uInt32 getWord(const uInt8* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | ((uInt32)in[3] << 24);
+}
+
+/* the MD5 in hex as 16 bytes; characters which are not hex digits count as 0 */
+static void packMD5(const string& md5, uInt8* out) {
+    memset(out, 0, 16);
+    for (size_t i = 0; i < md5.size() && i < 32; i++) {
+        char c = md5[i];
+        int digit = (c >= '0' && c <= '9') ? c - '0' :
+                    (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                    (c >= 'A' && c <= 'F') ? c - 'A' + 10 : 0;
+        out[i / 2] |= (i % 2 == 0) ? digit << 4 : digit;
+    }
+}
+
+
+void packStateBlob(const string& payload, const string& rom_md5, bool compress,
+                   string& blob) {
+    uLongf stored_size = payload.size();
+    blob.resize(BLOB_HEADER_SIZE + (compress ? compressBound(payload.size()) : payload.size()));
+    uInt8* header = (uInt8*)&blob[0];
+    uInt8* data = header + BLOB_HEADER_SIZE;
+
+    // A payload which does not get smaller is stored as it is
+    if (compress) {
+        stored_size = compressBound(payload.size());
+        compress = compress2(data, &stored_size, (const Bytef*)payload.data(),
+                             payload.size(), Z_BEST_SPEED) == Z_OK &&
+                   stored_size < payload.size();
+        if (!compress)
+            stored_size = payload.size();
+    }
+    if (!compress && !payload.empty())
+        memcpy(data, payload.data(), payload.size());
+    blob.resize(BLOB_HEADER_SIZE + stored_size);
+    header = (uInt8*)&blob[0];
+
+    memcpy(header, BLOB_MAGIC, 4);
+    header[4] = STATE_BLOB_VERSION;
+    header[5] = compress ? STATE_BLOB_COMPRESSED : 0;
+    header[6] = header[7] = 0;
+    packMD5(rom_md5, header + 8);
+    putWord(header + 24, payload.size());
+    putWord(header + 28, stored_size);
+    putWord(header + 32, crc32(0, (const Bytef*)payload.data(), payload.size()));
+}
+
+
+bool unpackStateBlob(const string& blob, const string& rom_md5, string& payload) {
+    const uInt8* header = (const uInt8*)blob.data();
+    if (blob.size() < BLOB_HEADER_SIZE || memcmp(header, BLOB_MAGIC, 4) != 0) {
+        cerr << "Not an ALE state blob" << endl;
+        return false;
+    }
+    if (header[4] != STATE_BLOB_VERSION) {
+        cerr << "Unsupported state blob version " << (int)header[4] << endl;
+        return false;
+    }
+
+    uInt8 md5[16];
+    packMD5(rom_md5, md5);
+    if (memcmp(header + 8, md5, 16) != 0) {
+        cerr << "The state blob is for another ROM" << endl;
+        return false;
+    }
+
+    uLongf size = getWord(header + 24);
+    uInt32 stored_size = getWord(header + 28);
+    if (stored_size != blob.size() - BLOB_HEADER_SIZE) {
+        cerr << "The state blob is truncated" << endl;
+        return false;
+    }
+    if (size > BLOB_MAX_SIZE) {
+        cerr << "The state blob is damaged" << endl;
+        return false;
+    }
+
+    const Bytef* data = (const Bytef*)blob.data() + BLOB_HEADER_SIZE;
+    payload.resize(size);
+    if (header[5] & STATE_BLOB_COMPRESSED) {
+        uLongf expected = size;
+        if (uncompress((Bytef*)&payload[0], &size, data, stored_size) != Z_OK ||
+            size != expected) {
+            cerr << "The state blob is damaged" << endl;
+            return false;
+        }
+    }
+    else if (size != stored_size) {
+        cerr << "The state blob is damaged" << endl;
+        return false;
+    }
+    else if (size > 0)
+        memcpy(&payload[0], data, size);
+
+    if (crc32(0, (const Bytef*)payload.data(), payload.size()) != getWord(header + 32)) {
+        cerr << "The state blob is damaged" << endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool writeStateBlob(FILE* file, const string& blob) {
+    uInt8 size[4];
+    putWord(size, blob.size());
+    return fwrite(size, 1, 4, file) == 4 &&
+           fwrite(blob.data(), 1, blob.size(), file) == blob.size() &&
+           fflush(file) == 0;
+}
+
+
+bool readStateBlob(FILE* file, string& blob) {
+    uInt8 size[4];
+    if (fread(size, 1, 4, file) != 4 || getWord(size) > BLOB_MAX_SIZE) return false;
+    blob.resize(getWord(size));
+    return blob.empty() || fread(&blob[0], 1, blob.size(), file) == blob.size();
+}
@@ -0,0 +1,53 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  state_blob.h
+ *
+ *  Framing for the portable state blobs of ALEInterface::exportState, which
+ *  can be shipped to another process or machine running the same ROM. The
+ *  payload itself is written with a compact Serializer, so it is the same
+ *  on every host; this adds a header to check it against, and optionally
+ *  compresses it.
+ *
+ *  Blob layout, little-endian: "ALEB", u8 version, u8 flags, u16 zero, the
+ *  ROM's MD5 as 16 bytes, u32 payload size, u32 stored size, u32 CRC32 of
+ *  the payload, then the payload (zlib-compressed if flagged).
+ *
+ *  Blobs written to a file or pipe with writeStateBlob are preceded by their
+ *  u32 size, so that a stream of them can be read back with readStateBlob.
+ **************************************************************************** */
+
+#ifndef STATE_BLOB_H
+#define STATE_BLOB_H
+
+#include <cstdio>
+#include "Constants.h"
+
+#define STATE_BLOB_VERSION     2
+// Flags
+#define STATE_BLOB_COMPRESSED  1
+
+// Wraps the payload into a blob for the ROM with the given MD5 (in hex).
+// With compress the payload is compressed, unless that does not make it
+// smaller.
+void packStateBlob(const string& payload, const string& rom_md5, bool compress,
+                   string& blob);
+
+// Checks the blob and extracts its payload; returns false, with a message
+// on cerr, if it is damaged, of another version or for another ROM
+bool unpackStateBlob(const string& blob, const string& rom_md5, string& payload);
+
+// Writes a size-prefixed blob and flushes the file; returns false on error
+bool writeStateBlob(FILE* file, const string& blob);
+
+// Reads the next blob; returns false at the end of the file or on error
+bool readStateBlob(FILE* file, string& blob);
+
+#endif
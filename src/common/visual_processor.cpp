@@ -443,6 +443,8 @@ VisualProcessor::VisualProcessor(OSystem* _osystem, string myRomFile) :
     p_osystem(_osystem),
     game_settings(NULL),
     max_history_len(50), //numeric_limits<int>::max()),
+    screen_hist(_osystem->console().mediaSource().width() *
+                _osystem->console().mediaSource().height(), max_history_len),
     blob_ids(0), obj_ids(0), proto_ids(0),
     self_id(-1),
     focused_entity_id(-1), focus_level(-1), display_mode(0), display_self(false),
@@ -531,13 +533,16 @@ void VisualProcessor::process_image(const IntMatrix* screen_matrix, Action actio
 
     // Save State and action history
     blob_hist.push_back(curr_blobs);
-    screen_hist.push_back(*screen_matrix);
+    uInt8* hist_frame = screen_hist.nextFrame();
+    for (int i = 0; i < screen_height; i++)
+        for (int j = 0; j < screen_width; j++)
+            *hist_frame++ = (*screen_matrix)[i][j];
+    screen_hist.commit();
     action_hist.push_back(action);
-    assert(action_hist.size() == screen_hist.size());
-    assert(action_hist.size() == blob_hist.size());  
+    assert(action_hist.size() == blob_hist.size());
+    // The screen history is a ring of max_history_len frames
     while (action_hist.size() > max_history_len) {
         action_hist.pop_front();
-        screen_hist.pop_front();
         blob_hist.pop_front();
     }
 };
@@ -1439,7 +1444,11 @@ bool VisualProcessor::handleSDLEvent(const SDL_Event& event) {
     }
 
     if (refreshDisplay) {
-        IntMatrix screen_cpy(screen_hist.back());
+        const uInt8* last_screen = screen_hist.frame();
+        IntMatrix screen_cpy(screen_height, IntVect(screen_width));
+        for (int i = 0; i < screen_height; i++)
+            for (int j = 0; j < screen_width; j++)
+                screen_cpy[i][j] = *last_screen++;
         display_screen(screen_cpy, screen_width, screen_height);
         p_osystem->p_display_screen->display_screen(screen_cpy, screen_cpy[0].size(),screen_cpy.size());
                                                     
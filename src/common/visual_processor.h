@@ -13,6 +13,7 @@
 #include <deque>
 #include "Constants.h"
 #include "display_screen.h"
+#include "observation_history.h"
 #include "../games/RomSettings.hpp"
 #include "../emucore/OSystem.hxx"
 #include "../emucore/MediaSrc.hxx"
@@ -231,7 +232,7 @@ struct Prototype {
 class VisualProcessor : public SDLEventHandler {
 public:
     VisualProcessor(OSystem* _osystem, string myRomFile);
-    ~VisualProcessor() {};
+    ~VisualProcessor() { delete game_settings; };
         
     void process_image(const MediaSource& mediaSrc, Action a);
 
@@ -297,7 +298,7 @@ public:
 
     // History of past screens, actions, and blobs
     int max_history_len;
-    deque<IntMatrix>        screen_hist;
+    ObservationHistory      screen_hist;
     deque<Action>           action_hist;
     deque<map<long,Blob> >  blob_hist;
 
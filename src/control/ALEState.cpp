@@ -13,8 +13,6 @@
 #include "System.hxx"
 #include "Event.hxx"
 
-int ALEState::left_paddle_curr_x = PADDLE_DEFAULT_VALUE; 
-int ALEState::right_paddle_curr_x = PADDLE_DEFAULT_VALUE;
 
 /** Default constructor - loads settings from system */ 
 ALEState::ALEState(OSystem * osystem): m_osystem(osystem), m_settings(NULL) {
@@ -48,29 +46,63 @@ void ALEState::setSettings(RomSettings * settings) {
   * this object. */
 void ALEState::load() {
   assert(serialized.length() > 0);
-  assert(m_settings != NULL);
   Deserializer deser(serialized);
-  
-  m_osystem->console().system().loadState(s_cartridge_md5, deser);
-  m_settings->loadState(deser);
-  
-  left_paddle_curr_x = deser.getInt();
-  right_paddle_curr_x = deser.getInt();
-  frame_number = deser.getInt();
+  deserialize(deser, s_cartridge_md5);
 }
 
 void ALEState::save() {
-  assert(m_settings != NULL);
   Serializer ser;
-  
-  m_osystem->console().system().saveState(s_cartridge_md5, ser);
+  serialize(ser, s_cartridge_md5);
+  serialized = ser.get_str();
+}
+
+uInt32 ALEState::saveTo(uInt8* buffer, uInt32 capacity) {
+  Serializer ser(buffer, capacity);
+  try {
+    if (!serialize(ser, s_cartridge_md5)) return 0;
+  }
+  catch (const char*) {
+    return 0;
+  }
+  return ser.size();
+}
+
+void ALEState::loadFrom(const uInt8* data, uInt32 size) {
+  Deserializer deser(data, size);
+  deserialize(deser, s_cartridge_md5);
+}
+
+bool ALEState::exportTo(Serializer& ser) {
+  return serialize(ser, "");
+}
+
+bool ALEState::importFrom(Deserializer& deser) {
+  return deserialize(deser, "");
+}
+
+bool ALEState::serialize(Serializer& ser, const string& md5) {
+  assert(m_settings != NULL);
+  if (!m_osystem->console().system().saveState(md5, ser))
+    return false;
   m_settings->saveState(ser);
   
-  ser.putInt(left_paddle_curr_x);
-  ser.putInt(right_paddle_curr_x);
+  ser.putInt(left_paddle_curr_x());
+  ser.putInt(right_paddle_curr_x());
   ser.putInt(frame_number);
+  return true;
+}
 
-  serialized = ser.get_str();
+bool ALEState::deserialize(Deserializer& deser, const string& md5) {
+  assert(m_settings != NULL);
+  if (!m_osystem->console().system().loadState(md5, deser))
+    return false;
+  m_settings->loadState(deser);
+  
+  int left_paddle_x = deser.getInt();
+  int right_paddle_x = deser.getInt();
+  set_paddles(left_paddle_x, right_paddle_x);
+  frame_number = deser.getInt();
+  return true;
 }
 
 void ALEState::reset(int numResetSteps) {
@@ -120,43 +152,47 @@ void ALEState::default_paddles() {
 }
 
 void ALEState::set_paddles(int left, int right) {
-  left_paddle_curr_x = left; 
-  right_paddle_curr_x = right;
- 
   Event * event = m_osystem->event();
 
-  int left_resistance = calc_paddle_resistance(left_paddle_curr_x);
+  int left_resistance = calc_paddle_resistance(left);
     event->set(Event::PaddleZeroResistance, left_resistance);
-  int right_resistance = calc_paddle_resistance(right_paddle_curr_x);
+  int right_resistance = calc_paddle_resistance(right);
     event->set(Event::PaddleOneResistance, right_resistance);
 }
 
+/* The paddle positions are kept in the emulator's Event object, as the paddle
+ * resistances (calc_paddle_resistance is the identity), so that every emulator
+ * in the process has its own. */
+int ALEState::left_paddle_curr_x() const {
+  return m_osystem->event()->get(Event::PaddleZeroResistance);
+}
+
+int ALEState::right_paddle_curr_x() const {
+  return m_osystem->event()->get(Event::PaddleOneResistance);
+}
+
 /* *********************************************************************
  *  Updates the positions of the paddles, and sets an event for 
  *  updating the corresponding paddle's resistance
  * ********************************************************************/
  void ALEState::update_paddles_positions(int delta_left, int delta_right) {
-    Event * event = m_osystem->event();
-
-    left_paddle_curr_x += delta_left;
-    if (left_paddle_curr_x < PADDLE_MIN) {
-        left_paddle_curr_x = PADDLE_MIN;
+    int left_x = left_paddle_curr_x() + delta_left;
+    if (left_x < PADDLE_MIN) {
+        left_x = PADDLE_MIN;
     } 
-    if (left_paddle_curr_x >  PADDLE_MAX) {
-        left_paddle_curr_x = PADDLE_MAX;
+    if (left_x >  PADDLE_MAX) {
+        left_x = PADDLE_MAX;
     }
-    int left_resistance = calc_paddle_resistance(left_paddle_curr_x);
-    
-    event->set(Event::PaddleZeroResistance, left_resistance);
-    right_paddle_curr_x += delta_right;
-    if (right_paddle_curr_x < PADDLE_MIN) {
-        right_paddle_curr_x = PADDLE_MIN;
+
+    int right_x = right_paddle_curr_x() + delta_right;
+    if (right_x < PADDLE_MIN) {
+        right_x = PADDLE_MIN;
     } 
-    if (right_paddle_curr_x >  PADDLE_MAX) {
-        right_paddle_curr_x = PADDLE_MAX;
+    if (right_x >  PADDLE_MAX) {
+        right_x = PADDLE_MAX;
     }
-    int right_resistance = calc_paddle_resistance(right_paddle_curr_x);
-    event->set(Event::PaddleOneResistance, right_resistance);
+
+    set_paddles(left_x, right_x);
 }
 
 
@@ -497,3 +533,9 @@ void ALEState::reset_keys(Event* event) {
 bool ALEState::equals(ALEState &state) {
   return (state.serialized == this->serialized);
 }
+
+void ALEState::copySaved(const ALEState &state) {
+  assert(state.s_cartridge_md5 == s_cartridge_md5);
+  serialized = state.serialized;
+  frame_number = state.frame_number;
+}
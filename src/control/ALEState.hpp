@@ -54,8 +54,8 @@ class ALEState {
     string s_cartridge_md5;
 
   protected:
-    static int left_paddle_curr_x;   // Current x value for the left-paddle
-    static int right_paddle_curr_x;  // Current x value for the right-paddle
+    int left_paddle_curr_x() const;   // Current x value for the left-paddle
+    int right_paddle_curr_x() const;  // Current x value for the right-paddle
 
     // For debugging purposes, we store the frame number
     int frame_number;
@@ -118,7 +118,36 @@ class ALEState {
     /** Returns true if the two states contain the same saved information */
     bool equals(ALEState &state);
 
+    /** Copies the saved information of the given state, which may belong to 
+      *  another emulator running the same ROM. Call load() to apply it. */
+    void copySaved(const ALEState &state);
+
+    /** The saved information, e.g. to store it in a file */
+    const string& getSerialized() const { return serialized; }
+    /** Replaces the saved information with data from getSerialized() on an
+      *  emulator running the same ROM. Call load() to apply it. */
+    void setSerialized(const string& data) { serialized = data; }
+
+    /** Saves the current emulator state into the given buffer instead of this
+      *  object, e.g. a slot of an ALEStatePool. Returns the number of bytes
+      *  written, or 0 if they did not fit. */
+    uInt32 saveTo(uInt8* buffer, uInt32 capacity);
+    /** Restores a state written by saveTo; this object's own saved
+      *  information is left as it is. */
+    void loadFrom(const uInt8* data, uInt32 size);
+
+    /** Write or read the same information without the cartridge MD5, which
+      *  the caller checks instead; for the portable blobs of 
+      *  ALEInterface::exportState. Return false on failure. */
+    bool exportTo(Serializer& ser);
+    bool importFrom(Deserializer& deser);
+
   protected:
+    /** Writes or reads the emulator, ROM settings, paddles and frame number;
+      *  shared by save()/load() and saveTo()/loadFrom(). */
+    bool serialize(Serializer& ser, const string& md5);
+    bool deserialize(Deserializer& deser, const string& md5);
+
     /** Methods for updating the Event object (which contains joystick/paddle information) */
     void apply_action_paddles(Event * event_obj, int player_a_action, int player_b_action);
     void apply_action_joysticks(Event * event_obj, int player_a_action, int player_b_action);
@@ -0,0 +1,266 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ */
+#include <cstring>
+#include <algorithm>
+#include <zlib.h>
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+#include "ALEStateArchive.hpp"
+
+using boost::uint64_t;
+
+static const char ARCHIVE_MAGIC[8] = {'A', 'L', 'E', 'S', 'T', 'A', 'R', 'C'};
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_HEADER_SIZE 64
+#define ARCHIVE_COMPRESSED 1
+// Size and stored size before each state
+#define RECORD_HEADER_SIZE 8
+// Room left in each record beyond the measured state size
+#define RECORD_SLACK 64
+#define EMPTY_SLOT 0xFFFFFFFF
+
+ALEStateArchive::ALEStateArchive(const string& filename, ALEState* state, bool writable,
+                                 bool compress, uInt32 record_size):
+  p_state(state),
+  s_filename(filename),
+  b_writable(writable),
+  p_data(NULL),
+  i_mapped_size(0),
+  i_records(0) {
+
+  string md5 = p_state->getSystem()->console().properties().get(Cartridge_MD5);
+  md5.resize(32, ' ');
+  string index_filename = filename + ".idx";
+
+  // Saving never needs more than this
+  v_state.resize(1 << 20);
+
+  p_file = fopen(filename.c_str(), writable ? "r+b" : "rb");
+  if (p_file == NULL && writable) {
+    if (record_size == 0) {
+      uInt32 size = p_state->saveTo(&v_state[0], v_state.size());
+      if (size == 0) {
+        cerr << "Unable to size the state archive: the emulator state cannot be saved" << endl;
+        exit(-1);
+      }
+      record_size = RECORD_HEADER_SIZE + size + RECORD_SLACK;
+    }
+
+    uInt8 header[ARCHIVE_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    uInt32 fields[4] = {ARCHIVE_VERSION, record_size, compress ? ARCHIVE_COMPRESSED : 0, 0};
+    memcpy(header + 8, fields, sizeof(fields));
+    memcpy(header + 24, md5.data(), 32);
+
+    p_file = fopen(filename.c_str(), "w+b");
+    p_index_file = fopen(index_filename.c_str(), "w+b");
+    if (p_file != NULL) {
+      fwrite(header, 1, sizeof(header), p_file);
+      fflush(p_file);
+    }
+  }
+  else
+    p_index_file = fopen(index_filename.c_str(), writable ? "r+b" : "rb");
+
+  if (p_file == NULL || p_index_file == NULL) {
+    cerr << "Unable to open the state archive " << filename << endl;
+    exit(-1);
+  }
+
+  uInt8 header[ARCHIVE_HEADER_SIZE];
+  uInt32 fields[4];
+  if (fseek(p_file, 0, SEEK_SET) != 0 ||
+      fread(header, 1, sizeof(header), p_file) != sizeof(header) ||
+      memcmp(header, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+    cerr << "The file " << filename << " is not a state archive" << endl;
+    exit(-1);
+  }
+  memcpy(fields, header + 8, sizeof(fields));
+  if (fields[0] != ARCHIVE_VERSION || fields[1] <= RECORD_HEADER_SIZE) {
+    cerr << "Unsupported state archive " << filename << endl;
+    exit(-1);
+  }
+  if (memcmp(header + 24, md5.data(), 32) != 0) {
+    cerr << "The state archive " << filename << " is for another cartridge" << endl;
+    exit(-1);
+  }
+  i_record_size = fields[1];
+  b_compress = (fields[2] & ARCHIVE_COMPRESSED) != 0;
+  v_record.resize(i_record_size);
+
+  refresh();
+}
+
+ALEStateArchive::~ALEStateArchive() {
+#ifndef WIN32
+  if (p_data != NULL)
+    munmap(const_cast<uInt8*>(p_data), i_mapped_size);
+#endif
+  fclose(p_file);
+  fclose(p_index_file);
+}
+
+void ALEStateArchive::refresh() {
+  // Records count once they are complete in both files
+  fseek(p_file, 0, SEEK_END);
+  size_t data_size = ftell(p_file);
+  fseek(p_index_file, 0, SEEK_END);
+  size_t index_size = ftell(p_index_file);
+  size_t records = std::min((data_size - ARCHIVE_HEADER_SIZE) / i_record_size,
+                            index_size / sizeof(uint64_t));
+  if (records <= i_records) return;
+
+  v_hashes.resize(records);
+  fseek(p_index_file, i_records * sizeof(uint64_t), SEEK_SET);
+  if (fread(&v_hashes[i_records], sizeof(uint64_t), records - i_records, p_index_file) !=
+      records - i_records) {
+    cerr << "Unable to read the index of the state archive " << s_filename << endl;
+    exit(-1);
+  }
+  while (i_records < records)
+    indexRecord(i_records++);
+}
+
+long ALEStateArchive::append(uint64_t hash) {
+  assert(b_writable);
+  uInt8* data = &v_record[RECORD_HEADER_SIZE];
+  uInt32 capacity = i_record_size - RECORD_HEADER_SIZE;
+  uInt32 sizes[2];
+
+  if (b_compress) {
+    sizes[0] = p_state->saveTo(&v_state[0], v_state.size());
+    uLongf stored = capacity;
+    if (sizes[0] > 0 && compress2(data, &stored, &v_state[0], sizes[0], Z_BEST_SPEED) == Z_OK &&
+        stored < sizes[0])
+      sizes[1] = stored;
+    else if (sizes[0] > 0 && sizes[0] <= capacity) {
+      memcpy(data, &v_state[0], sizes[0]);
+      sizes[1] = sizes[0];
+    }
+    else
+      sizes[0] = 0;
+  }
+  else
+    sizes[0] = sizes[1] = p_state->saveTo(data, capacity);
+
+  if (sizes[0] == 0) {
+    cerr << "The state does not fit in the " << i_record_size << " byte records of "
+         << s_filename << endl;
+    return -1;
+  }
+  memcpy(&v_record[0], sizes, sizeof(sizes));
+  memset(data + sizes[1], 0, capacity - sizes[1]);
+
+  // The record goes first: the index entry is what makes it count. Any
+  // partial record left by a crash is overwritten.
+  fseek(p_file, ARCHIVE_HEADER_SIZE + i_records * i_record_size, SEEK_SET);
+  fseek(p_index_file, i_records * sizeof(uint64_t), SEEK_SET);
+  if (fwrite(&v_record[0], 1, i_record_size, p_file) != i_record_size || fflush(p_file) != 0 ||
+      fwrite(&hash, sizeof(hash), 1, p_index_file) != 1 || fflush(p_index_file) != 0) {
+    cerr << "Unable to write to the state archive " << s_filename << endl;
+    exit(-1);
+  }
+
+  v_hashes.push_back(hash);
+  indexRecord(i_records);
+  return i_records++;
+}
+
+const uInt8* ALEStateArchive::record(size_t n) {
+  size_t offset = ARCHIVE_HEADER_SIZE + n * i_record_size;
+#ifdef WIN32
+  fseek(p_file, offset, SEEK_SET);
+  if (fread(&v_record[0], 1, i_record_size, p_file) != i_record_size) {
+    cerr << "Unable to read the state archive " << s_filename << endl;
+    exit(-1);
+  }
+  return &v_record[0];
+#else
+  if (offset + i_record_size > i_mapped_size) {
+    // Map every record known, so that appends do not remap each time
+    if (p_data != NULL)
+      munmap(const_cast<uInt8*>(p_data), i_mapped_size);
+    i_mapped_size = ARCHIVE_HEADER_SIZE + i_records * i_record_size;
+    void* data = mmap(NULL, i_mapped_size, PROT_READ, MAP_SHARED, fileno(p_file), 0);
+    if (data == MAP_FAILED) {
+      cerr << "Unable to map the state archive " << s_filename << endl;
+      exit(-1);
+    }
+    p_data = static_cast<const uInt8*>(data);
+  }
+  return p_data + offset;
+#endif
+}
+
+void ALEStateArchive::restore(size_t n) {
+  assert(n < i_records);
+  const uInt8* data = record(n);
+  uInt32 sizes[2];
+  memcpy(sizes, data, sizeof(sizes));
+  data += RECORD_HEADER_SIZE;
+  if (sizes[1] > i_record_size - RECORD_HEADER_SIZE || sizes[0] > v_state.size()) {
+    cerr << "Record " << n << " of the state archive " << s_filename << " is damaged" << endl;
+    exit(-1);
+  }
+
+  // Uncompressed states are read in place
+  if (sizes[1] == sizes[0]) {
+    p_state->loadFrom(data, sizes[0]);
+    return;
+  }
+  uLongf size = sizes[0];
+  if (uncompress(&v_state[0], &size, data, sizes[1]) != Z_OK || size != sizes[0]) {
+    cerr << "Record " << n << " of the state archive " << s_filename << " is damaged" << endl;
+    exit(-1);
+  }
+  p_state->loadFrom(&v_state[0], sizes[0]);
+}
+
+void ALEStateArchive::indexRecord(size_t n) {
+  // Keep the table at most half full
+  if (2 * (n + 1) > v_table.size()) {
+    v_table.assign(std::max((size_t)1024, 2 * v_table.size()), EMPTY_SLOT);
+    for (size_t i = 0; i < n; i++)
+      indexRecord(i);
+  }
+
+  size_t mask = v_table.size() - 1;
+  size_t slot = (v_hashes[n] ^ (v_hashes[n] >> 32)) & mask;
+  while (v_table[slot] != EMPTY_SLOT)
+    slot = (slot + 1) & mask;
+  v_table[slot] = n;
+}
+
+void ALEStateArchive::find(uint64_t hash, std::vector<size_t>& records) const {
+  records.clear();
+  if (v_table.empty()) return;
+
+  size_t mask = v_table.size() - 1;
+  for (size_t slot = (hash ^ (hash >> 32)) & mask; v_table[slot] != EMPTY_SLOT;
+       slot = (slot + 1) & mask) {
+    if (v_hashes[v_table[slot]] == hash)
+      records.push_back(v_table[slot]);
+  }
+  std::sort(records.begin(), records.end());
+}
+
+uint64_t ALEStateArchive::hashBytes(const uInt8* data, size_t length) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
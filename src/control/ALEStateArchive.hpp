@@ -0,0 +1,100 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ALEStateArchive.hpp
+ *
+ *  An append-only file of saved emulator states, for exploration methods
+ *   which keep far more states than fit in memory. Records have a fixed
+ *   size, so record n is found without any table, and the file is mapped
+ *   rather than read: several processes can read the same archive and share
+ *   its pages, while one process appends to it. Each record is stored
+ *   under a hash given by the caller (e.g. of the RAM or the screen) and
+ *   can be looked up by it.
+ *
+ *  Files: 'filename' holds a 64 byte header ("ALESTARC", u32 version,
+ *   u32 record size, u32 flags, u32 zero, the cartridge MD5 as 32 chars)
+ *   and the records: u32 state size, u32 stored size, then the state,
+ *   zlib-compressed if the stored size is smaller. 'filename.idx' holds
+ *   the u64 hash of each record. Values are in the host's byte order. A
+ *   record only counts once it is in both files, so an archive cut short
+ *   by a crash is still valid.
+ **************************************************************************** */
+
+#ifndef __ALESTATEARCHIVE_HPP__
+#define __ALESTATEARCHIVE_HPP__
+
+#include <cstdio>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include "ALEState.hpp"
+
+class ALEStateArchive {
+  public:
+    /** Opens the archive of states of the given emulator's cartridge. A
+      *  writable archive is created if the file does not exist, with records
+      *  of record_size bytes, or sized for the current state uncompressed if
+      *  record_size is 0; with compress, states are stored compressed when
+      *  that is smaller, so smaller records can be asked for. Both settings
+      *  are kept in the file. Exits if the file is not an archive for this
+      *  cartridge. */
+    ALEStateArchive(const string& filename, ALEState* state, bool writable,
+                    bool compress = false, uInt32 record_size = 0);
+    ~ALEStateArchive();
+
+    /** Appends the current emulator state under the given hash. Returns
+      *  its record number, or -1 if it does not fit in a record. Only one
+      *  process may append to an archive. */
+    long append(boost::uint64_t hash);
+
+    /** Restores the emulator to the state of record n. */
+    void restore(size_t n);
+
+    /** Number of records */
+    size_t size() const { return i_records; }
+    boost::uint64_t hash(size_t n) const { return v_hashes[n]; }
+
+    /** Fills records with the numbers of the records stored under the
+      *  given hash, in increasing order. */
+    void find(boost::uint64_t hash, std::vector<size_t>& records) const;
+
+    /** Picks up the records appended by another process since. */
+    void refresh();
+
+    /** A 64-bit FNV-1a hash, e.g. of the RAM or the screen */
+    static boost::uint64_t hashBytes(const uInt8* data, size_t length);
+
+  protected:
+    /** Returns record n, mapping the file further if needed */
+    const uInt8* record(size_t n);
+
+    void indexRecord(size_t n);
+
+  protected:
+    ALEState* p_state;
+    string s_filename;
+    bool b_writable;
+    bool b_compress;
+    uInt32 i_record_size;
+
+    FILE* p_file;
+    FILE* p_index_file;
+    const uInt8* p_data;          // The mapped part of the file
+    size_t i_mapped_size;
+
+    size_t i_records;
+    std::vector<boost::uint64_t> v_hashes;
+    std::vector<uInt32> v_table;  // Record numbers by hash, open addressing
+
+    std::vector<uInt8> v_record;  // A record being written, or read on WIN32
+    std::vector<uInt8> v_state;   // A state being compressed or uncompressed
+};
+
+#endif // __ALESTATEARCHIVE_HPP__
+
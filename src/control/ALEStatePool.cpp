@@ -0,0 +1,100 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ */
+#include <cstddef>
+#include "ALEStatePool.hpp"
+#include "Serializer.hxx"
+
+// Room left in each slot beyond the measured state size
+#define SLOT_SLACK 64
+// Slots start on cache line boundaries
+#define SLOT_ALIGNMENT 64
+
+ALEStatePool::ALEStatePool(ALEState* state, int slots_per_slab):
+  p_state(state),
+  i_slots_per_slab(slots_per_slab > 0 ? slots_per_slab : 1),
+  i_next_slab(0),
+  i_next_in_slab(0),
+  p_free(NULL),
+  i_allocated(0) {
+
+  // A cartridge type always saves to the same size; measure it once
+  uInt32 size = 0;
+  std::vector<uInt8> probe(64 * 1024);
+  while ((size = p_state->saveTo(&probe[0], probe.size())) == 0) {
+    if (probe.size() >= 16 * 1024 * 1024) {
+      cerr << "Unable to size the state pool: the emulator state cannot be saved" << endl;
+      exit(-1);
+    }
+    probe.resize(probe.size() * 2);
+  }
+
+  i_capacity = size + SLOT_SLACK;
+  i_stride = offsetof(ALEStateSlot, data) + i_capacity;
+  i_stride = (i_stride + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+}
+
+ALEStatePool::~ALEStatePool() {
+  for (size_t i = 0; i < v_slabs.size(); i++)
+    delete [] v_slabs[i];
+}
+
+ALEStateSlot* ALEStatePool::acquire() {
+  ALEStateSlot* slot;
+  if (p_free != NULL) {
+    slot = p_free;
+    p_free = slot->next_free;
+  } else {
+    if (i_next_in_slab == i_slots_per_slab) {
+      i_next_slab++;
+      i_next_in_slab = 0;
+    }
+    if (i_next_slab == v_slabs.size())
+      v_slabs.push_back(new uInt8[(size_t)i_slots_per_slab * i_stride + SLOT_ALIGNMENT]);
+
+    // new[] only guarantees the alignment of the largest scalar type
+    uInt8* slab = v_slabs[i_next_slab];
+    slab += (SLOT_ALIGNMENT - (size_t)slab % SLOT_ALIGNMENT) % SLOT_ALIGNMENT;
+    slot = (ALEStateSlot*)(slab + (size_t)i_next_in_slab * i_stride);
+    i_next_in_slab++;
+  }
+  i_allocated++;
+  return slot;
+}
+
+ALEStateSlot* ALEStatePool::save() {
+  ALEStateSlot* slot = acquire();
+  slot->size = p_state->saveTo(slot->data, i_capacity);
+  if (slot->size == 0) {
+    cerr << "The emulator state no longer fits in the state pool's "
+         << i_capacity << " byte slots" << endl;
+    exit(-1);
+  }
+  return slot;
+}
+
+void ALEStatePool::load(const ALEStateSlot* slot) {
+  p_state->loadFrom(slot->data, slot->size);
+}
+
+void ALEStatePool::release(ALEStateSlot* slot) {
+  slot->next_free = p_free;
+  p_free = slot;
+  i_allocated--;
+}
+
+void ALEStatePool::releaseAll() {
+  p_free = NULL;
+  i_next_slab = 0;
+  i_next_in_slab = 0;
+  i_allocated = 0;
+}
+
@@ -0,0 +1,82 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ALEStatePool.hpp
+ *
+ *  A pool of fixed-size slots for saved emulator states, for search trees
+ *   which keep many of them. Each ALEState owns a string which save() 
+ *   reallocates and its copy constructor copies; slots instead come from 
+ *   large slabs, sized once for the cartridge being played, and are reused. 
+ *   Saving to and restoring from a slot allocates nothing once the slabs 
+ *   are there, and all the slots of a search iteration can be given back 
+ *   at once with releaseAll().
+ *
+ *  A slot holds what ALEState::save() would: the emulator, the ROM settings,
+ *   the paddles and the frame number. It can only be restored into the 
+ *   emulator it was saved from.
+ **************************************************************************** */
+
+#ifndef __ALESTATEPOOL_HPP__
+#define __ALESTATEPOOL_HPP__
+
+#include <vector>
+#include "ALEState.hpp"
+
+/** A saved state. Only valid until it is released. */
+struct ALEStateSlot {
+  uInt32 size;               // Bytes used in data
+  ALEStateSlot* next_free;   // Next slot in the free list, while released
+  uInt8 data[1];             // Really slotCapacity() bytes
+};
+
+class ALEStatePool {
+  public:
+    /** The slots are sized by saving the state of the given emulator once;
+      *  each slab holds slots_per_slab of them. */
+    ALEStatePool(ALEState* state, int slots_per_slab = 1024);
+    ~ALEStatePool();
+
+    /** Saves the current emulator state into a new slot. */
+    ALEStateSlot* save();
+
+    /** Restores the emulator to the state saved in the given slot. */
+    void load(const ALEStateSlot* slot);
+
+    /** Gives a slot back to the pool. */
+    void release(ALEStateSlot* slot);
+
+    /** Gives every slot back at once; the slabs are kept for reuse. */
+    void releaseAll();
+
+    /** Bytes available for a state in each slot */
+    uInt32 slotCapacity() const { return i_capacity; }
+    /** Slots handed out and not released */
+    int numAllocated() const { return i_allocated; }
+    /** Bytes held in slabs */
+    size_t memoryUsed() const { return v_slabs.size() * i_slots_per_slab * i_stride; }
+
+  protected:
+    ALEStateSlot* acquire();
+
+  protected:
+    ALEState* p_state;
+    uInt32 i_capacity;
+    uInt32 i_stride;              // Bytes between two slots
+    int i_slots_per_slab;
+
+    std::vector<uInt8*> v_slabs;
+    size_t i_next_slab;           // Slab the next fresh slot comes from
+    int i_next_in_slab;           // Slots already handed out from it
+    ALEStateSlot* p_free;         // Released slots
+    int i_allocated;
+};
+
+#endif // __ALESTATEPOOL_HPP__
+
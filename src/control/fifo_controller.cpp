@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "fifo_controller.h"
+#include "fifo_pipeline.h"
 #include "Serializer.hxx"
 #include "Deserializer.hxx"
 
@@ -26,6 +27,9 @@
 #include "RomSettings.hpp"
 
 #define MAX_RUN_LENGTH (0xFF)
+// In delta mode, changed pixels separated by at most this many unchanged ones
+//  are sent as one span; a span header costs as much as four pixels
+#define MAX_SPAN_GAP 4
 
 static const char hexval[] = { 
     '0', '1', '2', '3', '4', '5', '6', '7', 
@@ -38,6 +42,12 @@ inline void appendByte(char *buf, uInt8 v) {
     *buf++ = hexval[v & 0xF];
 }
 
+/* appends a 16-bit value to the string buffer, as four characters */
+inline void appendWord(char *buf, uInt16 v) {
+    appendByte(buf, v >> 8);
+    appendByte(buf + 2, v & 0xFF);
+}
+
 /* interface constructor */
 FIFOController::FIFOController(OSystem* _osystem, bool named_pipes) :
     GameController(_osystem) {
@@ -54,9 +64,53 @@ FIFOController::FIFOController(OSystem* _osystem, bool named_pipes) :
         exit(1);
     }
 
+    init();
+    handshake();
+}
+
+
+/* constructor for subclasses which open their own streams; the handshake
+   is performed later, once p_fin and p_fout have been set */
+FIFOController::FIFOController(OSystem* _osystem, FILE* fin, FILE* fout) :
+    GameController(_osystem) {
+    p_fin = fin;
+    p_fout = fout;
+
+    init();
+}
+
+
+/* reads the settings and allocates the frame buffers */
+void FIFOController::init() {
     i_max_num_frames_per_episode = p_osystem->settings().getInt("max_num_frames_per_episode");
     i_max_num_frames = p_osystem->settings().getInt("max_num_frames");
     b_run_length_encoding = p_osystem->settings().getBool("run_length_encoding");
+    b_pipelined = p_osystem->settings().getBool("pipelined_fifo");
+    i_delta_keyframe_interval = 0;
+    i_frames_since_keyframe = 0;
+    b_keyframe_requested = true;
+    p_pipeline = NULL;
+    p_speculation_state = NULL;
+    i_speculations = 0;
+    i_speculation_hits = 0;
+
+    // Initialize our copy of frame_buffer
+    pi_old_frame_buffer = new uInt32[i_screen_width * i_screen_height];
+    // this frame buffer contains the phosphor blended frame 
+    pi_curr_frame_buffer = new uInt32[i_screen_width * i_screen_height];
+    for (int i = 0; i < i_screen_width * i_screen_height; i++) {
+        pi_old_frame_buffer[i] = -1;
+    }
+
+    // MGB @phosphor taken from default Stella settings
+    phosphor_blend_ratio   = 77;
+    i_current_frame_number = 0;
+    b_average_palette_ready = false;
+}
+
+
+/* sends the screen size and reads the agent's options */
+void FIFOController::handshake() {
     // send the width and height of the screen through the pipe
     char out_buffer [50];
     cerr << "i_screen_width = " << i_screen_width << " - i_screen_height =" <<   i_screen_height << endl;
@@ -67,7 +121,10 @@ FIFOController::FIFOController(OSystem* _osystem, bool named_pipes) :
     // get confirmation that the values were sent
     char in_buffer [50];
     cerr<< "A.L.E: waiting for a reply ..." << endl;
-    fgets (in_buffer, 50, p_fin);
+    if (fgets (in_buffer, 50, p_fin) == NULL) {
+        cerr << "A.L.E: the agent closed the pipe during the handshake" << endl;
+        exit(1);
+    }
     char * token = strtok (in_buffer,",\n");
     b_send_screen_matrix = atoi(token);
     token = strtok (NULL,",\n");
@@ -77,29 +134,39 @@ FIFOController::FIFOController(OSystem* _osystem, bool named_pipes) :
     i_skip_frames_counter = i_skip_frames_num;
     token = strtok(NULL, ",\n");
     b_send_rewards = atoi(token);
+    // Optional: agents which understand frame deltas send the keyframe interval
+    token = strtok(NULL, ",\n");
+    if (token != NULL) i_delta_keyframe_interval = atoi(token);
 
     cerr << "A.L.E: send_screen_matrix is: " << b_send_screen_matrix << endl;
     cerr << "A.L.E: send_console_ram is: " << b_send_console_ram << endl;
     cerr << "A.L.E: i_skip_frames_num is: " << i_skip_frames_num    << endl;
     cerr << "A.L.E: reinforcement learning mode: " << b_send_rewards << endl;
-
-    // Initialize our copy of frame_buffer
-    pi_old_frame_buffer = new uInt32[i_screen_width * i_screen_height];
-    // this frame buffer contains the phosphor blended frame 
-    pi_curr_frame_buffer = new uInt32[i_screen_width * i_screen_height];
-    for (int i = 0; i < i_screen_width * i_screen_height; i++) {
-        pi_old_frame_buffer[i] = -1;
+    if (i_delta_keyframe_interval > 0)
+        cerr << "A.L.E: sending frame deltas, keyframe every "
+             << i_delta_keyframe_interval << " frames" << endl;
+
+    if (b_pipelined) {
+        cerr << "A.L.E: pipelining the FIFO I/O" << endl;
+        p_pipeline = new FIFOPipeline(p_fin, p_fout);
+        p_speculation_state = new ALEState(state);
     }
-
-    // MGB @phosphor taken from default Stella settings
-    phosphor_blend_ratio   = 77;
-    i_current_frame_number = 0;
 }
 
 
 /* destructor */
 FIFOController::~FIFOController() {
 
+    if (p_pipeline != NULL) {
+        cerr << "A.L.E: " << i_speculation_hits << " of " << i_speculations
+             << " speculative frames were kept" << endl;
+        // An I/O thread blocked on the agent still uses the pipes
+        if (!p_pipeline->stop())
+            p_fin = p_fout = NULL;
+        delete p_pipeline;
+        delete p_speculation_state;
+    }
+
     if (p_fout != NULL) fclose(p_fout);
     if (p_fin != NULL)  fclose(p_fin);
 
@@ -113,10 +180,8 @@ FIFOController::~FIFOController() {
    are using, and applying the returned actions. */
 void FIFOController::update() {
 
-    static bool first_step = true;
-    if (first_step) {
+    if (!b_average_palette_ready) {
         makeAveragePalette();
-        first_step = false;
     }
 
     static char final_str[256000];
@@ -160,53 +225,72 @@ void FIFOController::update() {
 
             // MGB @phosphor
             phosphorBlend();
-            // The next section is taken from FrameBufferSoft
-            bool has_change = false;
-
-            int ind_j = 0, ind_i = 0;
-
-            int currentColor = -1;
-            int runLength = 0;
-
-            for (int i = 0; i < i_screen_width * i_screen_height; i++) {
-                uInt32 rgb = pi_curr_frame_buffer[i];
-                uInt8 col = rgbToNTSC(rgb);
-
-                if (b_run_length_encoding) {
-                  // Lengthen this run
-                  if (col == currentColor && runLength < MAX_RUN_LENGTH)
-                    runLength++;
-                  else {
-                    // Output it
-                    appendByte(final_str + final_str_n, currentColor);
-                    appendByte(final_str + final_str_n + 2, runLength);
-                    final_str_n += 4;
-
-                    // Switch to the new color
-                    currentColor = col;
-                    runLength = 1;
-                  }
-                }
 
-                else { // Output full screen
-                    appendByte(final_str + final_str_n, col); 
-                    final_str_n += 2;
+            // In delta mode the screen is prefixed by K (keyframe, encoded
+            //  as usual) or D (the spans which changed since the last frame)
+            bool keyframe = true;
+            if (i_delta_keyframe_interval > 0) {
+                keyframe = b_keyframe_requested ||
+                    i_frames_since_keyframe >= i_delta_keyframe_interval;
+                if (keyframe) {
+                    i_frames_since_keyframe = 0;
+                    b_keyframe_requested = false;
                 }
+                i_frames_since_keyframe++;
+                final_str[final_str_n++] = keyframe ? 'K' : 'D';
+            }
 
-                pi_old_frame_buffer[i] = col;
-                has_change = true;
-                ind_i++;
-                if (ind_i == i_screen_width) { ind_j++; ind_i = 0; }
+            if (!keyframe) {
+                final_str_n += appendScreenDelta(final_str + final_str_n);
+            } else {
+                // The next section is taken from FrameBufferSoft
+                bool has_change = false;
+
+                int ind_j = 0, ind_i = 0;
+
+                int currentColor = -1;
+                int runLength = 0;
+
+                for (int i = 0; i < i_screen_width * i_screen_height; i++) {
+                    uInt32 rgb = pi_curr_frame_buffer[i];
+                    uInt8 col = rgbToNTSC(rgb);
+
+                    if (b_run_length_encoding) {
+                      // Lengthen this run
+                      if (col == currentColor && runLength < MAX_RUN_LENGTH)
+                        runLength++;
+                      else {
+                        // Output it
+                        appendByte(final_str + final_str_n, currentColor);
+                        appendByte(final_str + final_str_n + 2, runLength);
+                        final_str_n += 4;
+
+                        // Switch to the new color
+                        currentColor = col;
+                        runLength = 1;
+                      }
+                    }
+
+                    else { // Output full screen
+                        appendByte(final_str + final_str_n, col); 
+                        final_str_n += 2;
+                    }
+
+                    pi_old_frame_buffer[i] = col;
+                    has_change = true;
+                    ind_i++;
+                    if (ind_i == i_screen_width) { ind_j++; ind_i = 0; }
                 
-            }
-            if (b_run_length_encoding && currentColor != -1) {
-              appendByte(final_str + final_str_n, currentColor);
-              appendByte(final_str + final_str_n + 2, runLength);
-              final_str_n += 4;
-            }
+                }
+                if (b_run_length_encoding && currentColor != -1) {
+                  appendByte(final_str + final_str_n, currentColor);
+                  appendByte(final_str + final_str_n + 2, runLength);
+                  final_str_n += 4;
+                }
 
-            // MGB - if no changes, we will send NADA
-            if (!has_change) final_str_n += sprintf(final_str + final_str_n, "NADA");
+                // MGB - if no changes, we will send NADA
+                if (!has_change) final_str_n += sprintf(final_str + final_str_n, "NADA");
+            }
             final_str_n += sprintf(final_str + final_str_n, ":");
         } // To be consistent, do not send anything when the screen is not requested
 
@@ -223,17 +307,38 @@ void FIFOController::update() {
         }
 
         final_str_n += sprintf(final_str + final_str_n, "\n");
-        fputs(final_str, p_fout);
-        fflush(p_fout);
-
-        // 2- Read the new action from the pipe
-        // the action is sent as player_a_action,player_b_action
-        char in_buffer[50];
-        fgets (in_buffer, 50, p_fin);
-        char * token = strtok (in_buffer,",\n");
-        player_a_action = (Action)atoi(token);
-        token = strtok (NULL,",\n");
-        player_b_action = (Action)atoi(token);
+
+        if (b_pipelined) {
+            // 2- Let the I/O thread send the frame and read the new action,
+            //  and emulate the next frame in the meantime
+            p_pipeline->sendObservation(final_str);
+            bool speculated = speculate();
+
+            if (!p_pipeline->receiveActions(player_a_action, player_b_action)) {
+                // The agent has closed the pipe; there is nothing left to do
+                exit(0);
+            }
+
+            if (speculated) {
+                if (player_a_action == e_previous_a_action &&
+                    player_b_action == e_previous_b_action) {
+                    // The prediction was right; keep the frame
+                    i_speculation_hits++;
+                    p_osystem->skipEmulation();
+                    return;
+                }
+                rollback();
+            }
+        } else {
+            fputs(final_str, p_fout);
+            fflush(p_fout);
+
+            // 2- Read the new action from the pipe
+            if (!readActions(p_fin, player_a_action, player_b_action)) {
+                // The agent has closed the pipe; there is nothing left to do
+                exit(0);
+            }
+        }
     }
 
     // MGB Handle special actions (no Atari action is actually taken)
@@ -254,6 +359,11 @@ void FIFOController::update() {
             systemReset();
             p_osystem->skipEmulation();
             return;
+        // Send the next screen in full (delta mode only)
+        case SEND_KEYFRAME:
+            b_keyframe_requested = true;
+            p_osystem->skipEmulation();
+            return;
         default:
             // Ignore all other actions; handle them as normal
             break;
@@ -265,6 +375,72 @@ void FIFOController::update() {
 }
 
 
+/* writes the pixels which differ from the last frame sent, as spans of
+   OOOOLLLL (hex offset and length) followed by the 2*LLLL hex pixels */
+int FIFOController::appendScreenDelta(char* buf) {
+    int n = 0;
+    int span_start = -1, span_end = -1;
+
+    for (int i = 0; i < i_screen_width * i_screen_height; i++) {
+        uInt8 col = rgbToNTSC(pi_curr_frame_buffer[i]);
+        if (col == pi_old_frame_buffer[i]) continue;
+        pi_old_frame_buffer[i] = col;
+
+        if (span_start >= 0 && i - span_end <= MAX_SPAN_GAP + 1) {
+            span_end = i;
+            continue;
+        }
+
+        // Output the previous span; pi_old_frame_buffer now holds its pixels
+        if (span_start >= 0) {
+            appendWord(buf + n, span_start);
+            appendWord(buf + n + 4, span_end - span_start + 1);
+            n += 8;
+            for (int j = span_start; j <= span_end; j++, n += 2)
+                appendByte(buf + n, pi_old_frame_buffer[j]);
+        }
+        span_start = span_end = i;
+    }
+
+    if (span_start >= 0) {
+        appendWord(buf + n, span_start);
+        appendWord(buf + n + 4, span_end - span_start + 1);
+        n += 8;
+        for (int j = span_start; j <= span_end; j++, n += 2)
+            appendByte(buf + n, pi_old_frame_buffer[j]);
+    }
+
+    return n;
+}
+
+
+/* emulates the next frame, assuming the agent repeats its previous actions */
+bool FIFOController::speculate() {
+    // Special actions are not repeated
+    if (e_previous_a_action >= PLAYER_B_NOOP && e_previous_a_action != RESET)
+        return false;
+
+    p_speculation_state->save();
+    state.apply_action(e_previous_a_action, e_previous_b_action);
+    p_console->mediaSource().update();
+    i_speculations++;
+    return true;
+}
+
+
+/* restores the state saved by speculate() */
+void FIFOController::rollback() {
+    p_speculation_state->load();
+
+    // The frame buffers are not part of the state. Once the real frame is
+    //  emulated the current buffer becomes the previous one, so it must hold
+    //  the last frame sent rather than the speculative one.
+    MediaSource& mediasrc = p_console->mediaSource();
+    memcpy(mediasrc.currentFrameBuffer(), mediasrc.previousFrameBuffer(),
+           i_screen_width * i_screen_height);
+}
+
+
 // MGB @phosphor
 void FIFOController::phosphorBlend() {
   uInt8 * current_buffer = p_console->mediaSource().currentFrameBuffer();
@@ -325,6 +501,8 @@ void FIFOController::makeAveragePalette() {
       }
     }
   }
+
+  b_average_palette_ready = true;
 }
 
 // MGB @phopshor
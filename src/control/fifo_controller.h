@@ -23,6 +23,7 @@
 #include "game_controller.h"
 
 class RomSettings;
+class FIFOPipeline;
 
 class FIFOController : public GameController {
 
@@ -41,9 +42,32 @@ class FIFOController : public GameController {
 
     protected:
 
+        // Used by subclasses that open their own streams. No handshake is
+        // performed; call handshake() once p_fin and p_fout are set.
+        FIFOController(OSystem* _osystem, FILE* fin, FILE* fout);
+
+        // Reads the settings and allocates the frame buffers
+        void init();
+
+        // Sends the screen size and reads the agent's options: send screen,
+        // send RAM, frame skip, send rewards and, optionally, the keyframe
+        // interval of delta mode
+        void handshake();
+
+        // Pipelined mode: emulates the next frame for the previous actions
+        // while the agent is thinking. Returns false if nothing was emulated.
+        bool speculate();
+
+        // Pipelined mode: undoes the speculative frame
+        void rollback();
+
         // Returns whether we have reached the maximum number of frames for this run 
         bool hasMaxFrames();
 
+        // Delta mode: writes the pixel spans which differ from the last
+        // frame sent, and returns the number of characters written
+        int appendScreenDelta(char* buf);
+
         void phosphorBlend();
         void makeAveragePalette();
         uInt8 getPhosphor(uInt8 v1, uInt8 v2);
@@ -60,6 +84,7 @@ class FIFOController : public GameController {
         
         uInt32 my_avg_palette[256][256];
         uInt8 phosphor_blend_ratio;
+        bool b_average_palette_ready;  // Set once makeAveragePalette has run
 
         int i_max_num_frames_per_episode;
         int i_max_num_frames;
@@ -67,8 +92,20 @@ class FIFOController : public GameController {
 
         bool b_run_length_encoding;
 
+        // Delta mode, negotiated in the handshake (0 = off)
+        int i_delta_keyframe_interval;  // Send a full frame every K frames
+        int i_frames_since_keyframe;
+        bool b_keyframe_requested;      // Set by the SEND_KEYFRAME action
+
         FILE* p_fout;               // Output Pipe
         FILE* p_fin;                // Input Pipe
+
+        // Pipelined mode (see fifo_pipeline.h)
+        bool b_pipelined;
+        FIFOPipeline* p_pipeline;       // The I/O thread, created by handshake()
+        ALEState* p_speculation_state;  // State before the speculative frame
+        int i_speculations;             // Number of speculative frames
+        int i_speculation_hits;         // ... which were kept
 };
 
 #endif  // __FIFO_CONTROLLER_H__
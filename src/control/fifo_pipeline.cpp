@@ -0,0 +1,152 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  fifo_pipeline.cpp
+ *
+ *  The implementation of the FIFOPipeline class, the I/O thread of a
+ * pipelined FIFOController.
+ **************************************************************************** */
+
+#include <string.h>
+#include <algorithm>
+
+#include "fifo_pipeline.h"
+
+bool readActions(FILE* fin, Action& player_a_action, Action& player_b_action) {
+    // the action is sent as player_a_action,player_b_action
+    char in_buffer[50];
+    if (fgets (in_buffer, 50, fin) == NULL)
+        return false;
+
+    char * token = strtok (in_buffer,",\n");
+    player_a_action = (Action)atoi(token);
+    token = strtok (NULL,",\n");
+    player_b_action = (Action)atoi(token);
+    return true;
+}
+
+
+// States of the I/O thread
+#define PIPE_IDLE       0   // Waiting for an observation
+#define PIPE_IO         1   // Talking to the agent, and possibly blocked doing so
+#define PIPE_STOP       2   // Asked to stop while idle
+#define PIPE_ABANDONED  3   // Left to finish its I/O; the pipeline may be gone
+
+// Polls of a queue spent spinning before sleeping, and the longest sleep,
+// as a power of two microseconds
+#define SPIN_POLLS       64
+#define MAX_SLEEP_SHIFT  8
+
+
+/* Waits between polls of a queue. The other side usually answers quickly,
+   so it spins at first; after that it sleeps for longer and longer, so that
+   a side kept waiting (e.g. while the agent thinks) does not hold a core. */
+class Backoff {
+    public:
+        Backoff() : i_polls(0) {}
+
+        void wait() {
+            if (i_polls < SPIN_POLLS) {
+                i_polls++;
+                boost::this_thread::yield();
+                return;
+            }
+            int shift = std::min(i_polls++ - SPIN_POLLS, MAX_SLEEP_SHIFT);
+            boost::this_thread::sleep(boost::posix_time::microseconds(1 << shift));
+        }
+
+        void reset() { i_polls = 0; }
+
+    protected:
+        int i_polls;
+};
+
+
+FIFOPipeline::FIFOPipeline(FILE* fin, FILE* fout) :
+    p_fin(fin), p_fout(fout), p_state(new boost::atomic<int>(PIPE_IDLE)) {
+    p_thread = new boost::thread(boost::bind(&FIFOPipeline::run, this, p_state));
+}
+
+
+FIFOPipeline::~FIFOPipeline() {
+    if (p_thread != NULL)
+        stop();
+}
+
+
+bool FIFOPipeline::stop() {
+    bool joined = false;
+    for (;;) {
+        int expected = PIPE_IDLE;
+        if (p_state->compare_exchange_strong(expected, PIPE_STOP)) {
+            p_thread->join();
+            joined = true;
+            break;
+        }
+        expected = PIPE_IO;
+        if (p_state->compare_exchange_strong(expected, PIPE_ABANDONED)) {
+            p_thread->detach();
+            break;
+        }
+    }
+    delete p_thread;
+    p_thread = NULL;
+    return joined;
+}
+
+
+void FIFOPipeline::sendObservation(const char* observation) {
+    Backoff backoff;
+    while (!q_observations.push(observation))
+        backoff.wait();
+}
+
+
+bool FIFOPipeline::receiveActions(Action& player_a_action, Action& player_b_action) {
+    ActionPair actions;
+    Backoff backoff;
+    while (!q_actions.pop(actions))
+        backoff.wait();
+
+    player_a_action = actions.a;
+    player_b_action = actions.b;
+    return !actions.eof;
+}
+
+
+void FIFOPipeline::run(boost::shared_ptr<boost::atomic<int> > state) {
+    Backoff idle;
+    for (;;) {
+        const char* observation;
+        if (!q_observations.pop(observation)) {
+            if (*state != PIPE_IDLE) return;
+            idle.wait();
+            continue;
+        }
+        idle.reset();
+
+        int expected = PIPE_IDLE;
+        if (!state->compare_exchange_strong(expected, PIPE_IO)) return;
+
+        fputs(observation, p_fout);
+        fflush(p_fout);
+        ActionPair actions;
+        actions.eof = !readActions(p_fin, actions.a, actions.b);
+
+        // Once abandoned, the pipeline may have been freed
+        expected = PIPE_IO;
+        if (!state->compare_exchange_strong(expected, PIPE_IDLE)) return;
+
+        Backoff backoff;
+        while (!q_actions.push(actions))
+            backoff.wait();
+        if (actions.eof) return;
+    }
+}
@@ -0,0 +1,80 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  fifo_pipeline.h
+ *
+ *  An I/O thread for the FIFOController. The emulator hands each observation
+ * to the thread, which writes it to the agent and reads back the actions,
+ * while the emulator is free to work on the next frame. The two threads talk
+ * through a pair of single-producer/single-consumer lock-free queues, and
+ * sleep between polls once a wait gets long.
+ **************************************************************************** */
+
+#ifndef __FIFO_PIPELINE_H__
+#define __FIFO_PIPELINE_H__
+
+#include <cstdio>
+#include <boost/thread.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "../common/Constants.h"
+
+/** Reads a "player_a_action,player_b_action" line; returns false on EOF */
+bool readActions(FILE* fin, Action& player_a_action, Action& player_b_action);
+
+class FIFOPipeline {
+
+    public:
+
+        FIFOPipeline(FILE* fin, FILE* fout);
+        ~FIFOPipeline();
+
+        // Stops the I/O thread and waits for it, unless it is blocked
+        // talking to the agent: it is then left to finish on its own, and
+        // still uses the pipes, so false is returned and they must not be
+        // closed. Called by the destructor if need be.
+        bool stop();
+
+        // Hands an observation line to the I/O thread. The buffer must stay
+        // untouched until the matching actions have been received.
+        void sendObservation(const char* observation);
+
+        // Waits for the actions which answer the last observation. Returns
+        // false if the agent closed the pipe.
+        bool receiveActions(Action& player_a_action, Action& player_b_action);
+
+    protected:
+
+        // Body of the I/O thread. The thread keeps its own reference to the
+        // state, which is all it touches once it has been abandoned.
+        void run(boost::shared_ptr<boost::atomic<int> > state);
+
+    protected:
+        struct ActionPair {
+            Action a, b;
+            bool eof;
+        };
+
+        FILE* p_fin;                // Input Pipe
+        FILE* p_fout;               // Output Pipe
+
+        boost::lockfree::spsc_queue<const char*,
+            boost::lockfree::capacity<2> > q_observations;
+        boost::lockfree::spsc_queue<ActionPair,
+            boost::lockfree::capacity<2> > q_actions;
+
+        // What the I/O thread is doing; see PIPE_IDLE, ...
+        boost::shared_ptr<boost::atomic<int> > p_state;
+        boost::thread* p_thread;
+};
+
+#endif  // __FIFO_PIPELINE_H__
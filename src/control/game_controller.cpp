@@ -18,6 +18,7 @@
 
 #include "game_controller.h"
 #include "Roms.hpp"
+#include "M6532.hxx"
 
 
 /* *********************************************************************
@@ -47,17 +48,30 @@ GameController::GameController(OSystem* _osystem): state(_osystem) {
     }
 
     state.setSettings(m_rom_settings);
+
+    if (p_osystem->settings().getBool("track_ram_writes"))
+        p_console->riot().trackRAMWrites(true);
     // MGB
     p_num_system_reset_steps = atoi(_osystem->settings().getString("system_reset_steps").c_str());
 
     systemReset();
 
+    p_dataset_writer = NULL;
+    string dataset = p_osystem->settings().getString("record_dataset");
+    if (dataset != "") {
+        p_dataset_writer = new DatasetWriter(dataset, i_screen_width, i_screen_height,
+          p_osystem->settings().getInt("dataset_keyframe_interval"));
+    }
 }
         
 /* *********************************************************************
     Destructor
  ******************************************************************** */
 GameController::~GameController() {
+    if (p_dataset_writer) {
+        delete p_dataset_writer;
+        p_dataset_writer = NULL;
+    }
     if (m_rom_settings) {
         delete m_rom_settings;
         m_rom_settings = NULL;
@@ -88,3 +102,12 @@ int GameController::read_ram(int offset) {
     return p_emulator_system->peek(offset + 0x80);
 }
 
+void GameController::recordStep(Action action, reward_t reward, int flags) {
+    if (p_dataset_writer == NULL) return;
+
+    uInt8 ram[RAM_LENGTH];
+    for (int i = 0; i < RAM_LENGTH; i++)
+        ram[i] = read_ram(i);
+    p_dataset_writer->record(p_console->mediaSource().currentFrameBuffer(), ram,
+                             action, reward, flags);
+}
@@ -22,6 +22,7 @@
 #include "../emucore/m6502/src/System.hxx"
 #include "ALEState.hpp"
 #include "../common/Constants.h"
+#include "../common/dataset_writer.h"
 
 #define PADDLE_DELTA 23000
 // MGB Values taken from Paddles.cxx (Stella 3.3) - 1400000 * [5,235] / 255
@@ -71,6 +72,13 @@ class GameController {
         Action getPreviousActionA() { return e_previous_a_action; };
         Action getPreviousActionB() { return e_previous_b_action; };
 
+        /* *********************************************************************
+         *  Adds the current screen and RAM to the dataset, if one is being
+         *  recorded (-record_dataset), along with the action which led to
+         *  them and its reward. DATASET_* flags mark episode boundaries.
+         * ********************************************************************/
+        void recordStep(Action action, reward_t reward, int flags);
+
     protected:
         OSystem* p_osystem;         // Pointer to Stella's OSystem object
         Event* p_global_event_obj;  // Pointer to the global event object
@@ -94,6 +102,8 @@ class GameController {
 
         // How many frames we want to send the reset action after a system reset
         int p_num_system_reset_steps;
+
+        DatasetWriter* p_dataset_writer;    // NULL unless recording a dataset
 };
 
 
@@ -19,6 +19,7 @@
 #include "RomSettings.hpp"
 #include "Roms.hpp"
 #include "PlayerAgent.hpp"
+#include "M6532.hxx"
 #include "Settings.hxx"
 
 #include "random_tools.h"
@@ -73,6 +74,13 @@ void InternalController::update() {
     cerr << "Reward " << m_rom_settings->getReward() << " Score " << episodeScore << endl;
   }
 
+  // The screen we are about to act on is the outcome of the previous action
+  if (first_step)
+    recordStep(PLAYER_A_NOOP, 0, DATASET_EPISODE_START);
+  else
+    recordStep(e_previous_a_action, m_rom_settings->getReward(),
+      isTerminal ? DATASET_TERMINAL : 0);
+
   if (first_step) {
     if (p_player_agent_left) player_a_action = p_player_agent_left->episode_start();
     else player_a_action = PLAYER_A_NOOP; 
@@ -94,6 +102,11 @@ void InternalController::update() {
     }
   }
 
+  // The agents have seen the RAM changes of the last frame
+  M6532& riot = p_console->riot();
+  if (riot.tracksRAMWrites())
+    riot.clearRAMChanges();
+
   bool resetRequested = false;
   
   if (player_a_action == RESET) {
@@ -2,9 +2,13 @@ MODULE := src/control
 
 MODULE_OBJS := \
 	src/control/ALEState.o \
+	src/control/ALEStateArchive.o \
+	src/control/ALEStatePool.o \
 	src/control/fifo_controller.o \
+	src/control/fifo_pipeline.o \
 	src/control/game_controller.o \
 	src/control/internal_controller.o \
+	src/control/server_controller.o \
 	
 MODULE_DIRS += \
 	src/control
@@ -0,0 +1,129 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  server_controller.cpp
+ *
+ * The implementation of the ServerController class, which forks a warm copy of
+ * the emulator for every agent that connects to its Unix socket.
+ **************************************************************************** */
+
+#include <string.h>
+#include <ctime>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "server_controller.h"
+
+#define SERVER_BACKLOG 64
+
+/* constructor; the streams are only opened in the forked children */
+ServerController::ServerController(OSystem* _osystem) :
+    FIFOController(_osystem, NULL, NULL) {
+    s_socket_path = p_osystem->settings().getString("server_socket");
+    i_listen_fd = -1;
+    b_serving_agent = false;
+}
+
+
+/* destructor */
+ServerController::~ServerController() {
+    if (i_listen_fd >= 0) {
+        close(i_listen_fd);
+        unlink(s_socket_path.c_str());
+    }
+}
+
+
+void ServerController::update() {
+    if (!b_serving_agent) {
+        // Warm the palette tables once, so that every child inherits them
+        if (!b_average_palette_ready)
+            makeAveragePalette();
+
+        serve();
+        b_serving_agent = true;
+        handshake();
+    }
+
+    FIFOController::update();
+}
+
+
+void ServerController::serve() {
+    struct sockaddr_un addr;
+    if (s_socket_path.length() >= sizeof(addr.sun_path)) {
+        cerr << "A.L.E: socket path is too long: " << s_socket_path << endl;
+        exit(1);
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, s_socket_path.c_str());
+
+    i_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (i_listen_fd < 0) {
+        perror("A.L.E: socket");
+        exit(1);
+    }
+
+    unlink(s_socket_path.c_str());
+    if (bind(i_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(i_listen_fd, SERVER_BACKLOG) < 0) {
+        perror("A.L.E: cannot listen on socket");
+        exit(1);
+    }
+
+    // Children are reaped automatically
+    signal(SIGCHLD, SIG_IGN);
+
+    cerr << "A.L.E: server waiting for agents on " << s_socket_path << endl;
+
+    for (;;) {
+        int fd = accept(i_listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            perror("A.L.E: accept");
+            exit(1);
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("A.L.E: fork");
+            close(fd);
+            continue;
+        }
+
+        if (pid == 0) {
+            // Child: drop the listening socket and talk to the agent
+            close(i_listen_fd);
+            i_listen_fd = -1;
+            signal(SIGCHLD, SIG_DFL);
+
+            p_fin = fdopen(fd, "r");
+            p_fout = fdopen(dup(fd), "w");
+            if (p_fin == NULL || p_fout == NULL) {
+                perror("A.L.E: fdopen");
+                exit(1);
+            }
+
+            // Children forked from the same image would otherwise share
+            // the random sequence
+            if (p_osystem->settings().getString("random_seed") == "time")
+                srand((unsigned)time(0) ^ (unsigned)getpid());
+            return;
+        }
+
+        close(fd);
+    }
+}
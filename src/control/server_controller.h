@@ -0,0 +1,49 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and 
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details. 
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  server_controller.h
+ *
+ *  The implementation of the ServerController class, which is a subclass of
+ * FIFOController. The ROM is loaded and the system reset once; the server
+ * then listens on a local Unix socket and forks a child for every agent that
+ * connects. Each child starts from the warm (copy-on-write) image and talks
+ * the FIFO protocol over its connection.
+ **************************************************************************** */
+
+#ifndef __SERVER_CONTROLLER_H__
+#define __SERVER_CONTROLLER_H__
+
+#include "fifo_controller.h"
+
+class ServerController : public FIFOController {
+
+    public:
+
+        ServerController(OSystem* _osystem);
+        virtual ~ServerController();
+
+        // The first call accepts connections and never returns in the server
+        // process. In the forked child it returns after the handshake, and
+        // every later call behaves as in FIFOController.
+        virtual void update();
+
+    protected:
+
+        // Listens on the socket and forks a child per connection. Only returns
+        // in the child, with p_fin and p_fout attached to the connection.
+        void serve();
+
+    protected:
+        string s_socket_path;       // Path of the Unix socket to listen on
+        int i_listen_fd;            // Listening socket (-1 in the children)
+        bool b_serving_agent;       // True once this process owns a connection
+};
+
+#endif  // __SERVER_CONTROLLER_H__
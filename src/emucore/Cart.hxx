@@ -66,6 +66,15 @@ class Cartridge : public Device
     */
     static const string& about() { return myAboutString; }
 
+    /**
+      Try to auto-detect the bankswitching type of the cartridge
+
+      @param image  A pointer to the ROM image
+      @param size   The size of the ROM image 
+      @return The "best guess" for the cartridge type
+    */
+    static string autodetectType(const uInt8* image, uInt32 size);
+
     /**
       Save the internal (patched) ROM image.
 
@@ -116,7 +125,7 @@ class Cartridge : public Device
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size) = 0;
+    virtual const uInt8* getImage(int& size) = 0;
 
   protected:
     // If bankLocked is true, ignore attempts at bankswitching. This is used
@@ -124,15 +133,6 @@ class Cartridge : public Device
     bool bankLocked;
 
   private:
-    /**
-      Try to auto-detect the bankswitching type of the cartridge
-
-      @param image  A pointer to the ROM image
-      @param size   The size of the ROM image 
-      @return The "best guess" for the cartridge type
-    */
-    static string autodetectType(const uInt8* image, uInt32 size);
-
     /**
       Search the image for the specified byte signature
 
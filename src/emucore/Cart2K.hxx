@@ -120,7 +120,7 @@ class Cartridge2K : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -140,7 +140,7 @@ class Cartridge2K : public Cartridge
 
   private:
     // The 2k ROM image for the cartridge
-    uInt8 myImage[2048];
+    const uInt8* myImage;
 };
 
 #endif
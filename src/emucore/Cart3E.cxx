@@ -29,14 +29,8 @@
 Cartridge3E::Cartridge3E(const uInt8* image, uInt32 size)
   : mySize(size)
 {
-  // Allocate array for the ROM image
-  myImage = new uInt8[mySize];
-
-  // Copy the ROM image into my buffer
-  for(uInt32 addr = 0; addr < mySize; ++addr)
-  {
-    myImage[addr] = image[addr];
-  }
+  // Point into the shared ROM image
+  myImage = image;
 
   // Initialize RAM with random values
   class Random random;
@@ -49,7 +43,6 @@ Cartridge3E::Cartridge3E(const uInt8* image, uInt32 size)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge3E::~Cartridge3E()
 {
-  delete[] myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -286,23 +279,12 @@ int Cartridge3E::bankCount()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge3E::patch(uInt16 address, uInt8 value)
 {
-  address = address & 0x0FFF;
-  if(address < 0x0800)
-  {
-    if(myCurrentBank < 256)
-      myImage[(address & 0x07FF) + myCurrentBank * 2048] = value;
-    else
-      myRam[(address & 0x03FF) + (myCurrentBank - 256) * 1024] = value;
-  }
-  else
-  {
-    myImage[(address & 0x07FF) + mySize - 2048] = value;
-  }
-  return true;
+  // The ROM image is shared between consoles, so it can't be patched
+  return false;
 } 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8* Cartridge3E::getImage(int& size)
+const uInt8* Cartridge3E::getImage(int& size)
 {
   size = mySize;
   return &myImage[0];
@@ -149,7 +149,7 @@ class Cartridge3E : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -171,8 +171,8 @@ class Cartridge3E : public Cartridge
     // Indicates which bank is currently active for the first segment
     uInt16 myCurrentBank;
 
-    // Pointer to a dynamically allocated ROM image of the cartridge
-    uInt8* myImage;
+    // Pointer to the shared ROM image of the cartridge
+    const uInt8* myImage;
 
     // RAM contents. For now every ROM gets all 32K of potential RAM
     uInt8 myRam[32768];
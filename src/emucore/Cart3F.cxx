@@ -28,20 +28,13 @@
 Cartridge3F::Cartridge3F(const uInt8* image, uInt32 size)
   : mySize(size)
 {
-  // Allocate array for the ROM image
-  myImage = new uInt8[mySize];
-
-  // Copy the ROM image into my buffer
-  for(uInt32 addr = 0; addr < mySize; ++addr)
-  {
-    myImage[addr] = image[addr];
-  }
+  // Point into the shared ROM image
+  myImage = image;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge3F::~Cartridge3F()
 {
-  delete[] myImage;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -223,20 +216,12 @@ int Cartridge3F::bankCount()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge3F::patch(uInt16 address, uInt8 value)
 {
-  address = address & 0x0FFF;
-  if(address < 0x0800)
-  {
-    myImage[(address & 0x07FF) + myCurrentBank * 2048] = value;
-  }
-  else
-  {
-    myImage[(address & 0x07FF) + mySize - 2048] = value;
-  }
-  return true;
+  // The ROM image is shared between consoles, so it can't be patched
+  return false;
 } 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8* Cartridge3F::getImage(int& size)
+const uInt8* Cartridge3F::getImage(int& size)
 {
   size = mySize;
   return &myImage[0];
@@ -126,7 +126,7 @@ class Cartridge3F : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -148,8 +148,8 @@ class Cartridge3F : public Cartridge
     // Indicates which bank is currently active for the first segment
     uInt16 myCurrentBank;
 
-    // Pointer to a dynamically allocated ROM image of the cartridge
-    uInt8* myImage;
+    // Pointer to the shared ROM image of the cartridge
+    const uInt8* myImage;
 
     // Size of the ROM image
     uInt32 mySize;
@@ -96,7 +96,7 @@ bool Cartridge4A50::patch(uInt16 address, uInt8 value)
 } 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8* Cartridge4A50::getImage(int& size)
+const uInt8* Cartridge4A50::getImage(int& size)
 {
   size = 0;
   return 0;
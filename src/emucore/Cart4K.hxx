@@ -119,7 +119,7 @@ class Cartridge4K : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -139,7 +139,7 @@ class Cartridge4K : public Cartridge
 
   private:
     // The 4K ROM image for the cartridge
-    uInt8 myImage[4096];
+    const uInt8* myImage;
 };
 
 #endif
@@ -593,7 +593,7 @@ bool CartridgeAR::patch(uInt16 address, uInt8 value)
 } 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8* CartridgeAR::getImage(int& size)
+const uInt8* CartridgeAR::getImage(int& size)
 {
   size = myNumberOfLoadImages * 8448;
   return &myLoadImages[0];
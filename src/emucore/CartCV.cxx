@@ -30,11 +30,8 @@ CartridgeCV::CartridgeCV(const uInt8* image, uInt32 size)
   uInt32 addr;
   if(size == 2048)
   {
-    // Copy the ROM image into my buffer
-    for(uInt32 addr = 0; addr < 2048; ++addr)
-    {
-      myImage[addr] = image[addr];
-    }
+    // Point into the shared ROM image
+    myImage = image;
 
     // Initialize RAM with random values
     class Random random;
@@ -48,11 +45,8 @@ CartridgeCV::CartridgeCV(const uInt8* image, uInt32 size)
     // The game has something saved in the RAM
     // Usefull for MagiCard program listings
 
-    // Copy the ROM image into my buffer
-    for(addr = 0; addr < 2048; ++addr)
-    {
-      myImage[addr] = image[addr + 2048];
-    }
+    // Point into the shared ROM image
+    myImage = image + 2048;
 
     // Copy the RAM image into my buffer
     for(addr = 0; addr < 1024; ++addr)
@@ -210,12 +204,12 @@ int CartridgeCV::bankCount()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeCV::patch(uInt16 address, uInt8 value)
 {
-  myImage[address & 0x07FF] = value;
-  return true;
+  // The ROM image is shared between consoles, so it can't be patched
+  return false;
 } 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8* CartridgeCV::getImage(int& size)
+const uInt8* CartridgeCV::getImage(int& size)
 {
   size = 2048;
   return &myImage[0];
@@ -122,7 +122,7 @@ class CartridgeCV : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -142,7 +142,7 @@ class CartridgeCV : public Cartridge
 
   private:
     // The 2k ROM image for the cartridge
-    uInt8 myImage[2048];
+    const uInt8* myImage;
 
     // The 1024 bytes of RAM
     uInt8 myRAM[1024];
@@ -26,24 +26,9 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeDPC::CartridgeDPC(const uInt8* image, uInt32 size)
 {
-  uInt32 addr;
-
-  // Make a copy of the entire image as-is, for use by getImage()
-  // (this wastes 12K of RAM, should be controlled by a #ifdef)
-  for(addr = 0; addr < size; ++addr)
-    myImageCopy[addr] = image[addr];
-
-  // Copy the program ROM image into my buffer
-  for(addr = 0; addr < 8192; ++addr)
-  {
-    myProgramImage[addr] = image[addr];
-  }
-
-  // Copy the display ROM image into my buffer
-  for(addr = 0; addr < 2048; ++addr)
-  {
-    myDisplayImage[addr] = image[8192 + addr];
-  }
+  // Point into the shared ROM image for the program and display ROMs
+  myProgramImage = image;
+  myDisplayImage = image + 8192;
 
   // Initialize the DPC data fetcher registers
   for(uInt16 i = 0; i < 8; ++i)
@@ -590,22 +575,14 @@ int CartridgeDPC::bankCount()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeDPC::patch(uInt16 address, uInt8 value)
 {
-  address = address & 0x0FFF;
-  myProgramImage[myCurrentBank * 4096 + address] = value;
-  return true;
+  // The ROM image is shared between consoles, so it can't be patched
+  return false;
 } 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8* CartridgeDPC::getImage(int& size)
+const uInt8* CartridgeDPC::getImage(int& size)
 {
+  // The program ROM is the start of the raw image
   size = 8192 + 2048 + 255;
-
-  int i;
-  for(i = 0; i < 8192; i++)
-    myImageCopy[i] = myProgramImage[i];
-
-  for(i = 0; i < 2048; i++)
-    myImageCopy[i + 8192] = myDisplayImage[i];
-
-  return &myImageCopy[0];
+  return myProgramImage;
 }
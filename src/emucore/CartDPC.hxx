@@ -127,7 +127,7 @@ class CartridgeDPC : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -162,13 +162,10 @@ class CartridgeDPC : public Cartridge
     uInt16 myCurrentBank;
 
     // The 8K program ROM image of the cartridge
-    uInt8 myProgramImage[8192];
+    const uInt8* myProgramImage;
 
     // The 2K display ROM image of the cartridge
-    uInt8 myDisplayImage[2048];
-
-    // Copy of the raw image, for use by getImage()
-    uInt8 myImageCopy[8192 + 2048 + 255];
+    const uInt8* myDisplayImage;
 
     // The top registers for the data fetchers
     uInt8 myTops[8];
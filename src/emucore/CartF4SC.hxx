@@ -119,7 +119,7 @@ class CartridgeF4SC : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -142,7 +142,7 @@ class CartridgeF4SC : public Cartridge
     uInt16 myCurrentBank;
 
     // The 16K ROM image of the cartridge
-    uInt8 myImage[32768];
+    const uInt8* myImage;
 
     // The 128 bytes of RAM
     uInt8 myRAM[128];
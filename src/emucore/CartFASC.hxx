@@ -119,7 +119,7 @@ class CartridgeFASC : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -142,7 +142,7 @@ class CartridgeFASC : public Cartridge
     uInt16 myCurrentBank;
 
     // The 12K ROM image of the cartridge
-    uInt8 myImage[12288];
+    const uInt8* myImage;
 
     // The 256 bytes of RAM on the cartridge
     uInt8 myRAM[256];
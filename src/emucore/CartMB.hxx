@@ -120,7 +120,7 @@ class CartridgeMB : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A pointer to the internal ROM image data
     */
-    virtual uInt8* getImage(int& size);
+    virtual const uInt8* getImage(int& size);
 
   public:
     /**
@@ -149,7 +149,7 @@ class CartridgeMB : public Cartridge
     uInt16 myCurrentBank;
 
     // The 64K ROM image of the cartridge
-    uInt8 myImage[65536];
+    const uInt8* myImage;
 };
 
 #endif
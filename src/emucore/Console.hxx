@@ -27,6 +27,7 @@ class Switches;
 class System;
 
 #include "m6502/src/bspf/src/bspf.hxx"
+#include "EnvArena.hxx"
 #include "Control.hxx"
 #include "Props.hxx"
 #include "TIA.hxx"
@@ -43,6 +44,8 @@ class System;
 class Console
 {
   public:
+    ENV_ARENA_ALLOCATED
+
     /**
       Create a new console for emulating the specified game using the
       given game image and operating system.
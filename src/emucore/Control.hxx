@@ -24,6 +24,7 @@ class Event;
 class System;
 
 #include "m6502/src/bspf/src/bspf.hxx"
+#include "EnvArena.hxx"
 
 /**
   A controller is a device that plugs into either the left or right 
@@ -61,6 +62,8 @@ class System;
 class Controller
 {
   public:
+    ENV_ARENA_ALLOCATED
+
     /**
       Enumeration of the controller jacks
     */
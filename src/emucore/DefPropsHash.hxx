@@ -0,0 +1,255 @@
+#ifndef DEF_PROPS_HASH_HXX
+#define DEF_PROPS_HASH_HXX
+
+/**
+  This code is generated using the 'create_props_hash' program,
+  located in the src/tools directory.  It must be regenerated
+  whenever DefProps.hxx changes.
+*/
+
+#define DEF_PROPS_HASH_BUCKETS 681
+#define DEF_PROPS_HASH_SIZE 3062
+#define DEF_PROPS_HASH_EMPTY 0xFFFF
+
+static const uInt16 DefPropsHashDisplacement[DEF_PROPS_HASH_BUCKETS] = {
+  1,10,7,1,2,25,1,6,11,6,1,3,0,24,3,3,
+  29,23,27,18,4,125,5,1,2,2,7,9,4,56,3,11,
+  2,0,7,27,9,11,48,7,0,0,0,9,0,11,23,6,
+  0,60,18,1,0,0,0,2,7,1,8,0,2,0,4,11,
+  10,11,11,1,26,93,7,28,13,37,14,12,12,0,2,109,
+  0,1,0,11,17,1,3,49,8,3,7,15,64,3,13,8,
+  13,3,16,40,0,10,25,46,1,5,62,18,22,7,12,5,
+  4,73,0,42,3,2,2,8,22,6,8,34,51,0,9,150,
+  15,8,0,26,98,1,8,15,17,12,106,5,6,140,0,2,
+  39,2,8,8,46,0,12,4,1,58,1,25,0,10,1,247,
+  47,0,44,7,2,1,0,0,8,0,21,0,0,3,25,8,
+  2,5,28,31,86,0,0,63,8,70,0,1,7,11,3,2,
+  0,3,80,4,9,1,3,14,11,95,1,96,23,3,13,3,
+  7,5,43,13,5,48,23,6,17,3,10,3,0,3,16,8,
+  7,23,15,1,11,2,26,7,0,15,52,1,26,57,5,9,
+  39,53,37,18,13,70,14,16,5,19,24,33,250,16,3,0,
+  1,2,0,16,26,189,2,8,27,2,102,5,5,4,1,0,
+  9,3,88,2,0,4,5,16,4,1,20,50,104,28,11,1,
+  53,48,1,42,12,1,58,22,1,2,5,105,0,43,11,16,
+  111,3,28,1,0,29,2,4,4,4,100,35,9,1,6,13,
+  4,9,0,0,40,2,1,51,43,80,4,5,0,36,55,112,
+  0,18,0,7,2,54,2,37,8,25,0,74,6,6,32,37,
+  3,6,0,1,99,40,78,3,46,11,16,2,63,7,50,10,
+  3,3,106,6,35,0,24,3,60,0,33,0,18,47,67,0,
+  62,56,2,90,5,14,5,29,70,5,5,127,7,13,1,190,
+  19,120,126,9,89,12,31,27,9,0,9,210,0,38,27,7,
+  6,53,6,0,32,39,5,30,2,4,2,186,6,107,34,72,
+  0,5,90,17,10,155,18,4,63,126,26,7,6,0,73,2,
+  11,0,7,1,55,0,0,0,86,3,52,3,100,13,76,23,
+  0,3,0,3,7,0,8,11,127,1,67,2,14,7,57,121,
+  18,96,5,3,14,55,1,54,201,99,130,93,17,86,74,41,
+  189,40,32,2,23,62,35,39,10,19,9,0,16,43,6,40,
+  47,39,21,25,3,0,3,22,17,0,3,1,60,49,1,12,
+  145,25,0,9,166,50,0,132,32,0,58,0,25,71,2,80,
+  55,2,5,119,0,16,0,129,4,1,0,17,130,1,54,22,
+  14,9,5,1,2,30,0,1,4,322,82,1,5,0,24,54,
+  34,17,14,101,89,193,54,34,74,223,169,3,18,56,0,18,
+  32,45,1,34,5,34,9,80,0,1,29,188,2,9,21,48,
+  23,3,98,1,15,250,31,97,27,26,350,39,21,182,5,41,
+  21,0,3,88,1,137,1,36,3,177,184,53,7,24,31,4,
+  5,3,44,2,159,98,42,3,0,10,98,141,55,197,1,4,
+  94,0,40,30,30,12,4,21,2,0,0,288,0,37,20,30,
+  3,68,101,186,2,4,2,2,2
+};
+
+static const uInt16 DefPropsHashSlot[DEF_PROPS_HASH_SIZE] = {
+  1050,2247,415,1684,2335,441,1017,2037,65535,2691,2061,1414,2612,2545,2122,2515,
+  893,2054,65535,351,1812,826,170,1241,2198,260,235,1580,822,65535,979,1360,
+  65535,2110,2349,2475,1614,2415,124,902,2205,2119,65535,1737,65535,2285,2598,2126,
+  1829,657,365,618,1511,518,2402,2365,1691,2697,1216,1004,2654,1789,65535,1642,
+  586,1707,1019,2088,65535,1613,768,1839,2418,1758,1201,65535,60,470,1443,1394,
+  1524,65535,2076,1681,1001,936,65535,1152,2583,2351,2387,1600,1140,918,65535,278,
+  1042,837,1367,25,65535,2166,2263,1971,1598,1146,686,758,948,2072,1918,2548,
+  1970,1094,1270,1391,282,2556,756,1137,65535,2043,2700,728,65535,1142,65535,299,
+  390,2658,2361,775,2507,1237,2015,398,65535,1937,84,1564,798,472,1425,65535,
+  2607,735,158,1569,1079,2298,65535,545,1537,2485,2050,2047,510,2197,1035,614,
+  65535,1706,1771,1227,683,714,1556,1795,1110,1680,515,101,1276,2140,1866,821,
+  2563,1250,825,2044,420,65535,699,542,65535,1223,926,1272,1340,982,1127,2327,
+  1842,2138,41,1196,1946,2647,2091,65535,2492,1206,656,1560,1046,828,1125,848,
+  2555,710,984,65535,1975,891,65535,783,1636,1297,423,2329,990,1974,2448,361,
+  1260,2623,385,273,159,529,1904,814,804,2086,1549,1306,597,1808,65535,963,
+  612,1100,1625,80,2038,1997,418,1824,65535,546,634,1939,2026,1190,102,1634,
+  222,358,976,1214,2315,2686,754,813,2177,1869,1832,321,65535,65535,1709,1688,
+  1734,894,1521,1069,1368,2303,166,651,65535,1871,2354,1733,1596,1178,317,65535,
+  1611,841,1051,10,1210,2572,830,65535,1253,1741,215,628,2108,1464,2183,386,
+  1991,1120,2113,2223,920,65535,2463,1821,203,1949,835,363,571,1037,1667,65535,
+  147,1778,411,977,2493,753,2069,1677,2473,2370,2115,682,149,1857,1666,1176,
+  717,65535,1934,225,1877,839,605,2095,2067,2553,187,1400,1958,1078,1834,930,
+  627,2528,592,2350,65535,755,1154,296,2606,2690,1401,237,300,1742,700,2699,
+  1919,65535,65535,1507,96,309,941,782,65535,2486,65535,1550,65535,362,703,57,
+  2569,2597,70,913,65535,65535,345,2639,606,578,2529,1756,838,65535,901,65535,
+  2420,1112,2034,767,2121,134,2406,1483,308,2114,2218,304,8,617,527,2186,
+  2343,201,1488,2117,1361,1061,65535,2251,65535,2192,850,1315,709,1644,978,1581,
+  232,1294,805,1859,202,1170,219,2603,367,2176,738,1641,619,2206,2479,1604,
+  397,1768,2440,1690,2605,1928,65535,501,2453,908,2053,1313,1538,1389,1501,2356,
+  448,2589,2229,2094,2282,953,1790,381,823,489,2504,1953,2159,2385,1671,1831,
+  2527,65535,2221,2129,2081,2173,1235,2073,2342,421,2293,879,65535,2260,2611,65535,
+  65535,2359,259,2269,2449,63,580,332,1623,2571,2232,2478,1095,883,2390,258,
+  65535,481,65535,929,1107,1458,65535,2145,811,2408,2643,1893,1075,2395,254,1723,
+  643,104,1207,226,243,65535,1963,65535,1005,1761,244,65535,1254,65535,1330,2131,
+  505,1169,1779,2681,1231,1727,476,1876,2445,257,65535,731,2056,2609,42,2246,
+  1755,1467,65535,1230,729,2610,834,899,2550,2133,1447,306,9,155,1299,65535,
+  1186,2591,1496,1858,2185,65535,1811,65535,1841,2220,792,2021,1136,687,675,706,
+  1764,761,2132,1202,1554,2416,2648,2615,47,1105,946,1920,1685,853,65535,65535,
+  65535,1780,160,2314,1914,1678,1381,2151,972,117,1064,801,1895,65535,1328,1522,
+  1318,1628,2219,2153,1188,2215,35,1444,131,1558,743,65535,1455,2488,997,2587,
+  2641,769,2376,739,780,1802,1865,955,1899,607,983,1087,1823,95,1757,1660,
+  2310,1647,65535,65535,2625,107,2204,483,1448,65535,115,191,167,135,197,1503,
+  2719,1888,508,1192,1658,1491,2645,65535,1882,2084,2169,2467,610,16,1964,252,
+  692,65535,85,2340,1492,2511,2010,2520,531,1749,1081,65535,1160,65535,164,1233,
+  1408,494,2537,1713,1218,598,613,2136,2629,1082,12,123,1653,1663,314,81,
+  885,65535,65535,65535,2085,2505,794,75,366,402,143,943,553,1116,917,2580,
+  153,966,68,1342,1429,702,56,711,2331,65535,217,663,1843,65535,1020,65535,
+  543,425,744,2549,1783,752,1062,2321,1852,863,145,2146,519,2560,65535,861,
+  1221,404,1536,58,658,1682,810,1954,1674,1119,1326,451,1028,579,2676,173,
+  2480,1835,2687,1531,2495,832,1080,1911,1310,65535,2168,289,1332,2634,65535,83,
+  2060,1304,1891,65535,2595,388,1341,2264,2087,2657,126,2000,507,94,331,2318,
+  65535,887,346,2024,1662,65535,1139,2079,65535,324,103,940,2503,1219,65535,459,
+  2362,65535,65535,172,2253,1251,1335,1224,1605,26,1155,1412,1265,2297,2224,1450,
+  766,1138,1694,1870,442,1059,272,2665,745,1435,1519,695,2279,71,256,2437,
+  61,2451,884,65535,1875,405,497,723,1650,65535,1632,65535,65535,286,329,2336,
+  1791,2474,2484,629,88,1615,1482,2554,778,1863,342,169,785,1417,824,1282,
+  1815,2501,1339,426,2,2429,2216,2502,2339,1820,1213,1451,2324,1289,65535,537,
+  2694,65535,1150,2111,1716,2141,2311,2033,1978,993,1271,65535,1387,517,77,1984,
+  407,262,1057,770,1446,1916,120,2252,1880,65535,2618,556,220,2164,65535,2482,
+  1602,2617,674,371,2154,1705,1047,954,2499,818,2562,1477,816,1640,2619,1601,
+  1762,1379,2319,2267,2227,82,1542,1645,964,2624,1683,1131,2004,141,1787,377,
+  65535,65535,641,65535,2391,1243,2675,482,350,2228,55,2064,1191,1462,65535,2295,
+  15,2238,533,129,467,797,992,1966,1070,1392,740,944,890,1301,855,2542,
+  65535,2646,2052,479,2322,506,224,1638,376,646,733,644,2371,65535,625,2025,
+  1648,1721,1348,1836,31,65535,437,65535,2494,1166,691,65535,1063,2633,2380,267,
+  33,1942,2519,261,65535,291,65535,2421,1283,707,672,2599,2455,65535,1404,1936,
+  881,2660,1000,1347,65535,241,65535,253,1701,1708,1199,1460,776,1853,462,374,
+  1786,786,1900,2379,1695,1225,208,1738,263,1646,2352,1597,635,602,2239,2517,
+  870,2596,2307,2214,1526,65535,1985,1376,1849,2213,1333,1739,2524,65535,1772,1422,
+  1269,1134,1720,21,281,668,1156,734,1915,65535,349,882,1804,315,2381,2712,
+  1676,312,2411,1431,238,819,2464,114,265,1494,564,2711,1907,789,1331,2422,
+  488,65535,615,1456,65535,65535,1375,1923,1258,1357,960,1520,567,2713,178,2156,
+  2231,174,443,1011,852,583,64,909,1586,2137,1591,2009,1702,492,1935,2143,
+  65535,1830,621,34,1917,154,915,2278,1624,1009,741,937,1704,1799,846,2046,
+  847,1886,833,138,2518,975,1996,866,2398,395,989,2579,2234,2707,1180,1745,
+  854,2330,790,892,2672,829,2635,1153,522,746,1403,1998,1692,2135,2020,1043,
+  1840,242,2019,1659,1664,1365,2018,565,91,2513,1828,2160,2368,1045,1746,1548,
+  1388,1165,952,2706,279,1884,1440,368,65535,62,654,777,65535,2011,1769,177,
+  1358,156,1288,105,1687,2355,463,772,435,1255,1474,1076,2320,65535,65535,52,
+  1198,2065,65535,1089,1438,653,2477,2241,2508,2683,464,277,749,2005,162,1126,
+  2710,23,419,916,475,869,2139,175,2070,1719,1867,781,1433,2112,2207,1573,
+  812,1743,280,248,1794,2158,2414,2630,1378,910,65535,1717,65535,142,1234,2450,
+  939,2189,1344,548,2341,1371,65535,1476,720,183,305,2496,161,1018,1123,1781,
+  2048,38,337,65535,1311,1982,378,65535,65535,1514,600,65535,2541,295,1300,736,
+  65535,1279,413,595,1516,65535,681,843,2161,1818,1913,2720,1261,1364,65535,808,
+  1263,1504,1437,1285,2718,1668,2276,65535,779,1457,2170,65535,1712,212,87,325,
+  2190,1837,65535,851,29,1322,1599,2543,1922,2188,1722,65535,189,1879,0,921,
+  65535,1162,1325,1562,2405,708,2030,198,1098,640,65535,2535,1854,1961,255,1172,
+  2236,461,65535,1461,624,65535,639,1968,2628,445,414,1902,1947,1346,2257,800,
+  65535,539,65535,2399,1993,67,1044,65535,1509,359,652,424,1292,65535,2673,65535,
+  65535,1356,1106,1718,1753,596,287,412,1489,2059,65535,1925,2458,536,2098,2280,
+  65535,2344,231,1222,2684,65535,65535,32,2225,1534,469,872,434,820,1380,1290,
+  65535,65535,912,2575,125,44,1247,2490,2564,65535,2191,1475,207,604,65535,633,
+  934,2017,712,1016,1353,2714,364,1652,65535,802,458,2369,65535,563,1635,310,
+  1350,1352,1445,65535,391,572,65535,1568,2561,958,938,1965,1775,550,2709,1090,
+  22,500,133,608,2666,1967,1995,726,2557,2534,1951,688,1338,750,65535,330,
+  540,560,1983,2184,1211,318,1686,460,1773,2439,1760,1827,1822,2082,1798,1359,
+  2396,1513,2106,65535,877,50,2002,2226,1048,2284,2217,2620,942,1894,650,1430,
+  2594,150,65535,1544,532,1157,858,49,995,347,399,638,1240,109,36,65535,
+  1609,599,951,1383,2345,2016,196,1415,1442,408,1193,1174,1527,1994,65535,2698,
+  2039,1825,65535,339,1303,1071,1731,774,1517,1148,65535,947,1164,486,566,2582,
+  959,2547,344,65535,401,2498,2593,65535,1896,1608,2432,611,1945,945,1649,787,
+  1334,2693,1816,2627,513,2202,1058,298,2123,1128,65535,2035,65535,875,1908,499,
+  973,2552,122,457,576,1523,2669,228,1242,432,1728,65535,788,1181,65535,1454,
+  416,2659,322,2704,1056,468,65535,1878,935,1197,65535,705,1472,502,65535,2171,
+  1493,1637,1073,316,65535,2616,97,2032,807,2096,2413,2456,334,1810,1067,1976,
+  2012,1515,1397,2523,230,684,2585,65535,1546,1205,65535,1673,1266,2436,669,895,
+  7,302,660,65535,1948,1665,1386,1007,1363,1785,2165,65535,795,2255,79,2602,
+  1498,303,2308,139,1187,65535,2245,2174,2447,65535,2287,1868,2407,1657,620,65535,
+  2104,1370,369,65535,1320,6,1643,1327,1793,65535,65535,65535,2525,2296,1385,2045,
+  65535,1232,1215,65535,65535,65535,51,1374,900,1336,594,2386,1179,1002,2689,2103,
+  2040,128,2601,923,108,1796,1567,559,65535,65535,313,528,2640,1145,2301,889,
+  65535,1529,2148,570,428,1122,2346,2584,1309,1086,1930,65535,2294,1149,1273,1525,
+  2271,1031,904,648,1298,65535,121,2717,2668,327,65535,1689,1593,2155,1572,1351,
+  100,496,815,65535,28,2696,430,2261,17,144,1093,1817,1510,1797,65535,323,
+  1631,2326,65535,2466,999,2042,2500,1561,1185,2179,2465,111,251,65535,65535,392,
+  1189,1274,1887,2509,194,2444,1633,1505,1499,1316,69,1099,512,2544,2680,555,
+  737,1765,65535,525,1575,1373,968,623,2063,2389,911,1441,247,1897,2430,440,
+  65535,340,784,1029,2057,446,65535,1257,39,1940,732,678,2309,65535,389,274,
+  1236,2468,409,275,180,1003,1987,1194,357,2237,65535,759,285,971,65535,1715,
+  2222,1382,924,603,1144,1055,1014,269,1767,2621,1620,1814,65535,2066,2454,65535,
+  2388,2441,516,1337,2031,1774,65535,65535,65535,1845,1619,988,14,1724,375,73,
+  353,1074,2653,2291,218,2083,1986,2487,1801,65535,1729,1480,803,1329,503,2332,
+  1759,722,1212,534,2144,2105,1618,209,582,65535,991,1603,2491,719,1296,697,
+  65535,2130,165,2124,1302,836,341,1143,48,1419,2014,1979,2469,2510,2426,1763,
+  1566,1024,796,2292,1969,1512,455,538,1026,2522,2649,65535,897,1655,1725,2013,
+  2254,2431,65535,439,2360,65535,116,2678,949,379,2022,1470,2577,1345,1924,1819,
+  844,65535,575,2384,1486,65535,1314,2078,2302,454,1473,2353,65535,284,1856,373,
+  1850,2008,549,535,2481,561,1036,2604,1465,2299,2230,2313,1589,65535,666,2586,
+  422,195,1777,2401,2688,914,2404,748,1277,2526,986,65535,2092,352,1612,1175,
+  65535,1349,1065,2662,2392,1776,593,760,898,65535,65535,1571,680,1249,151,2608,
+  65535,1577,1317,1941,2090,1423,626,140,276,233,1147,857,1543,65535,113,65535,
+  2036,1584,1177,1424,86,65535,4,2483,862,859,65535,1275,1173,1471,65535,1851,
+  799,1873,1977,2041,679,577,417,1563,65535,2695,1121,888,2452,118,980,1238,
+  931,1530,227,65535,685,664,65535,1957,307,65535,1402,1883,394,2001,676,2357,
+  65535,1006,1200,1280,1184,2374,152,996,370,2142,355,2558,757,205,2512,2281,
+  1324,213,2677,587,856,1396,1484,1955,1421,338,13,1594,932,1319,444,2443,
+  1890,319,2425,763,1052,2248,171,65535,2461,868,2565,2382,1992,1606,907,1921,
+  1656,1540,1068,636,1545,1553,65535,450,288,2175,1167,2650,487,2097,465,562,
+  65535,1427,727,1630,130,1629,1744,1203,827,670,1960,1066,431,1101,1959,2347,
+  742,1559,1281,994,662,65535,622,2167,1590,1711,223,1806,1578,127,1468,249,
+  2570,2127,903,521,383,1102,427,2457,1855,485,179,2027,1010,1248,1295,1096,
+  1085,2273,320,2377,1861,65535,1848,1943,1039,1409,667,1487,1053,65535,2546,1220,
+  1557,817,1740,65535,544,436,2568,1268,1552,2080,1844,967,1508,1784,65535,1113,
+  2259,860,637,328,1901,1533,1372,1141,1159,66,2358,1097,311,671,2685,186,
+  2424,2093,1670,981,214,704,806,928,2459,65535,2210,157,526,65535,2283,65535,
+  569,1321,2195,1008,2152,1730,1416,1570,406,1585,1502,504,2576,176,20,2551,
+  585,1054,1699,1617,65535,701,925,65535,65535,2003,98,1151,1449,2099,2397,2306,
+  181,1226,2403,673,1420,2049,1587,132,1616,1826,65535,65535,65535,1399,773,2149,
+  2438,2400,1860,2256,2249,1115,65535,2410,477,873,2275,1284,906,65535,1607,2652,
+  1038,1479,1244,2393,65535,1217,2007,333,905,240,2266,2664,93,1022,2655,1651,
+  491,665,2670,473,1286,1735,65535,1846,65535,1555,2642,65535,1903,65535,76,1679,
+  1813,2211,1377,1023,2235,541,65535,1163,2100,2334,65535,2071,2372,1654,1576,2023,
+  1418,2288,43,65535,642,2101,1551,2250,1933,146,1788,65535,969,74,1432,2412,
+  2516,1751,987,2409,1355,1130,1956,1426,1626,690,696,2702,495,2147,2258,1574,
+  1354,2208,1672,2203,1091,1293,1889,360,65535,2300,2348,1034,1307,698,2705,1528,
+  2638,2539,65535,1129,200,65535,2622,2077,1697,65535,2567,840,974,2338,193,18,
+  11,65535,2181,2109,343,2692,1366,65535,998,2540,490,210,2674,1204,1595,764,
+  1183,2233,65535,2614,661,1703,1565,1291,1872,1406,1124,2435,1343,65535,65535,65535,
+  655,380,429,2378,2128,433,1439,1278,65535,1092,2337,301,2514,865,1926,927,
+  89,1929,498,1809,581,188,1033,922,1469,266,2532,65535,471,1,148,192,
+  2632,1168,2367,2442,1025,1478,37,2472,2631,730,724,1252,2270,1405,2364,65535,
+  2200,466,65535,1931,831,2062,1362,2588,1083,1944,2679,1407,1109,2366,2716,591,
+  1434,65535,452,65535,2671,809,2074,65535,1588,65535,530,264,354,524,645,2286,
+  2592,849,609,335,1390,2312,2613,65535,2107,348,2581,65535,293,480,45,211,
+  1710,1114,65535,2533,1308,182,2462,65535,864,716,1999,762,1030,1950,647,2423,
+  1485,216,1228,845,631,1490,1497,229,1500,554,2163,1980,1754,65535,677,493,
+  65535,630,65,1158,2120,40,1639,965,1410,1463,2323,1305,2538,1535,2068,1962,
+  1972,2193,715,970,1805,1874,185,616,1748,1714,65535,90,1453,1077,2446,523,
+  268,1060,65535,2029,1838,1041,65535,2417,65535,956,65535,297,514,1246,2373,65535,
+  65535,1675,65535,65535,2663,246,119,65535,221,1209,2157,2682,1208,1239,453,552,
+  791,46,1752,1736,65535,2317,2590,393,484,65535,2536,2289,65535,2661,65535,1013,
+  290,245,1015,933,694,2574,2600,1040,206,2118,1495,874,1898,65535,2304,961,
+  771,2637,2521,447,1012,1803,65535,568,1547,1621,1161,2201,356,2489,2116,2262,
+  65535,747,985,1518,1912,1398,2476,65535,2703,449,1864,1532,721,250,99,2383,
+  1693,2394,1973,2272,1481,2212,199,2150,1369,689,2178,558,184,65535,1323,557,
+  1267,962,1539,19,2559,78,793,1103,5,649,2701,2497,1171,765,1770,106,
+  957,65535,1807,2433,1413,65535,1195,92,1541,718,2328,1579,163,190,2715,1287,
+  1938,1661,65535,2470,2051,1988,551,588,387,30,283,1384,1847,438,1583,292,
+  1981,65535,1452,474,950,168,65535,1118,1952,1989,1133,72,400,520,65535,1312,
+  384,1698,270,1927,1132,1909,1264,65535,1833,1259,2531,659,65535,65535,867,1466,
+  1428,1905,1726,2427,2471,1582,204,65535,1072,3,65535,1032,65535,693,1782,1104,
+  1506,1747,2578,2506,2182,326,1592,751,410,2656,876,234,456,65535,137,871,
+  880,2162,2363,725,2325,1262,2667,2651,1906,573,2134,2419,574,1088,1800,1027,
+  1990,2305,2172,136,239,601,110,1792,1766,1892,919,713,2375,2240,2194,2268,
+  590,2460,65535,271,1245,54,1885,2530,589,1393,1021,2055,2180,1395,2199,2102,
+  842,65535,1182,1750,27,1108,1669,632,65535,1862,65535,236,1049,1459,1084,65535,
+  509,1696,2636,2242,584,2277,2316,24,65535,2721,336,1610,2187,2566,2434,547,
+  2058,1411,896,2274,1135,1117,2089,396,65535,1910,403,65535,65535,65535,2290,2075,
+  2209,65535,2428,2644,886,878,112,2028,2125,2243,65535,511,1627,372,1622,478,
+  2573,2708,294,1111,382,2626,1436,2333,59,2265,2196,1932,2006,1229,1256,1881,
+  1732,1700,65535,53,2244,65535
+};
+
+#endif
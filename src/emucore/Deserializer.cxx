@@ -16,35 +16,64 @@
 // $Id: Deserializer.cxx,v 1.12 2007/01/01 18:04:47 stephena Exp $
 //============================================================================
 
+#include <cstring>
 #include "Deserializer.hxx"
-#include <sstream>
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Deserializer::Deserializer(const string stream_str):
-myStream(stream_str) {
-    
+Deserializer::Deserializer(const string& stream_str, bool compact):
+myCompact(compact),
+myData(stream_str.data()),
+mySize(stream_str.size()),
+myPosition(0) {
 }
 
-
-
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Deserializer::Deserializer(const uInt8* data, uInt32 size, bool compact):
+myCompact(compact),
+myData((const char*)data),
+mySize(size),
+myPosition(0) {
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Deserializer::close(void)
 {
-  myStream.clear();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const char* Deserializer::read(uInt32 length)
+{
+  if(length > mySize - myPosition)
+    throw "Deserializer: end of file";
+
+  const char* data = myData + myPosition;
+  myPosition += length;
+  return data;
+}
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Deserializer::getVarint(void)
+{
+  uInt32 value = 0;
+  for(int shift = 0; shift < 35; shift += 7)
+  {
+    uInt8 byte = *read(1);
+    value |= (uInt32)(byte & 0x7f) << shift;
+    if(!(byte & 0x80))
+      return value;
+  }
+  throw "Deserializer: data corruption";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Deserializer::getInt(void)
 {
-  if(myStream.eof())
-    throw "Deserializer: end of file";
+  if(myCompact)
+    return (int)getVarint();
 
   int val = 0;
-  unsigned char buf[4];
-  myStream.read((char*)buf, 4);
+  const unsigned char* buf = (const unsigned char*)read(4);
   for(int i = 0; i < 4; ++i)
     val += (int)(buf[i]) << (i<<3);
 
@@ -55,14 +84,10 @@ int Deserializer::getInt(void)
 string Deserializer::getString(void)
 {
   int len = getInt();
-  string str;
-  str.resize((string::size_type)len);
-  myStream.read(&str[0], (streamsize)len);
-
-  if(myStream.bad())
-    throw "Deserializer: file read failed";
+  if(len < 0)
+    throw "Deserializer: data corruption";
 
-  return str;
+  return string(read(len), len);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -70,6 +95,14 @@ bool Deserializer::getBool(void)
 {
   bool result = false;
 
+  if(myCompact)
+  {
+    uInt8 byte = *read(1);
+    if(byte > 1)
+      throw "Deserializer: data corruption";
+    return byte == 1;
+  }
+
   int b = getInt();
   if(b == (int)TruePattern)
     result = true;
@@ -80,3 +113,16 @@ bool Deserializer::getBool(void)
 
   return result;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double Deserializer::getDouble(void)
+{
+  unsigned long long bits = 0;
+  const unsigned char* buf = (const unsigned char*)read(8);
+  for(int i = 0; i < 8; ++i)
+    bits |= (unsigned long long)buf[i] << (i<<3);
+
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
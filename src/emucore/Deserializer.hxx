@@ -19,7 +19,6 @@
 #ifndef DESERIALIZER_HXX
 #define DESERIALIZER_HXX
 
-#include <sstream>
 #include "m6502/src/bspf/src/bspf.hxx"
 
 /**
@@ -35,15 +34,22 @@
  
  Revised for ALE on Sep 20, 2009
  The new version uses a stringstream (not a file stream)
- 
- TODO: don't copy the whole streams. 
+
+ The data is now read in place, without a copy; it must outlive the
+ Deserializer. Data written by a compact Serializer must be read by a
+ compact Deserializer.
  */
 class Deserializer {
     public:
         /**
          Creates a new Deserializer device.
          */
-        Deserializer(const string stream_str);
+        Deserializer(const string& stream_str, bool compact = false);
+
+        /**
+         Creates a new Deserializer device reading the given bytes.
+         */
+        Deserializer(const uInt8* data, uInt32 size, bool compact = false);
         
         void close(void);
 
@@ -67,11 +73,27 @@ class Deserializer {
          @result The boolean value which has been read from the stream.
          */
         bool getBool(void);
+
+        /**
+         Reads a double value written by Serializer::putDouble.
+         
+         @result The double value which has been read from the stream.
+         */
+        double getDouble(void);
         
         bool isOpen(void) {return true;}
     private:
-        // The stream to get the deserialized data from.
-        stringstream myStream;
+        // Returns the next length bytes; throws if there are not as many
+        const char* read(uInt32 length);
+        uInt32 getVarint(void);
+
+    private:
+        bool myCompact;
+
+        // The data to deserialize, and the position of the next read in it
+        const char* myData;
+        uInt32 mySize;
+        uInt32 myPosition;
         
         enum {
             TruePattern  = 0xfab1fab2,
@@ -0,0 +1,159 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+//============================================================================
+
+#include <assert.h>
+#include <stdlib.h>
+#include <new>
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+
+#include "EnvArena.hxx"
+
+#ifdef _MSC_VER
+  #define THREAD_LOCAL __declspec(thread)
+#else
+  #define THREAD_LOCAL __thread
+#endif
+
+// Every allocation is preceded by the arena it came from, or NULL for the
+// heap; this also keeps the memory aligned for any type
+static const size_t HEADER_SIZE = 16;
+
+// Size of the huge pages asked for with MAP_HUGETLB
+static const size_t HUGE_PAGE_SIZE = 2 << 20;
+
+static THREAD_LOCAL EnvArena* ourCurrent = 0;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+EnvArena::EnvArena(uInt32 capacity, bool hugePages)
+    : myBase(0),
+      myCapacity(capacity),
+      myRequestedCapacity(capacity),
+      myRequestedHugePages(hugePages),
+      myUsed(0),
+      myLive(0),
+      myMapped(false),
+      myHugePages(false)
+{
+#ifndef WIN32
+  void* base = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  // Explicit huge pages, if some were reserved
+  if(hugePages)
+  {
+    size_t size = (capacity + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    base = mmap(0, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(base != MAP_FAILED)
+    {
+      myCapacity = size;
+      myHugePages = true;
+    }
+  }
+#endif
+  if(base == MAP_FAILED)
+  {
+    base = mmap(0, myCapacity, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+    // Otherwise transparent huge pages, which need no reservation
+    if(hugePages && base != MAP_FAILED)
+      myHugePages = madvise(base, myCapacity, MADV_HUGEPAGE) == 0;
+#endif
+  }
+  if(base != MAP_FAILED)
+  {
+    myBase = (uInt8*)base;
+    myMapped = true;
+  }
+#endif
+
+  if(myBase == 0)
+    myBase = (uInt8*)::operator new(myCapacity);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+EnvArena::~EnvArena()
+{
+  assert(myLive == 0);
+  if(ourCurrent == this)
+    ourCurrent = 0;
+
+#ifndef WIN32
+  if(myMapped)
+  {
+    munmap(myBase, myCapacity);
+    return;
+  }
+#endif
+  ::operator delete(myBase);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+EnvArena::Scope::Scope(EnvArena* arena)
+    : myPrevious(ourCurrent)
+{
+  ourCurrent = arena;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+EnvArena::Scope::~Scope()
+{
+  ourCurrent = myPrevious;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void* EnvArena::allocate(size_t size)
+{
+  size_t needed = (HEADER_SIZE + size + HEADER_SIZE - 1) & ~(HEADER_SIZE - 1);
+  EnvArena* arena = ourCurrent;
+  uInt8* block;
+
+  if(arena != 0 && needed > arena->myCapacity - arena->myUsed)
+    arena = 0;
+
+  if(arena != 0)
+  {
+    block = arena->myBase + arena->myUsed;
+    arena->myUsed += needed;
+    arena->myLive++;
+  }
+  else
+    block = (uInt8*)::operator new(needed);
+
+  *(EnvArena**)block = arena;
+  return block + HEADER_SIZE;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EnvArena::release(void* p)
+{
+  if(p == 0)
+    return;
+
+  uInt8* block = (uInt8*)p - HEADER_SIZE;
+  EnvArena* arena = *(EnvArena**)block;
+  if(arena != 0)
+  {
+    // Start over once everything was freed, e.g. when a ROM is reloaded
+    if(--arena->myLive == 0)
+      arena->myUsed = 0;
+  }
+  else
+    ::operator delete(block);
+}
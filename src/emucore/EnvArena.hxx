@@ -0,0 +1,150 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+//============================================================================
+
+#ifndef ENVARENA_HXX
+#define ENVARENA_HXX
+
+#include <cstddef>
+
+#include "m6502/src/bspf/src/bspf.hxx"
+
+/**
+  A contiguous block of memory holding the emulator objects of one
+  environment (console, system, CPU, TIA and its frame buffers, RIOT,
+  cartridge, controllers, event), so that they sit together instead of
+  being spread over the heap among those of other environments.
+
+  Objects are placed in the arena made current on their thread by an
+  EnvArena::Scope while they are created; outside of a scope, or once the
+  arena is full, they come from the heap as usual.  Memory is handed out
+  in order, and all of it is reused once every object in the arena has
+  been freed.
+  The arena must outlive its objects, and must only be allocated from by
+  one thread at a time.
+
+  The classes which can be placed in an arena declare ENV_ARENA_ALLOCATED.
+*/
+class EnvArena
+{
+  public:
+    /**
+      Create an arena of the given size.
+
+      @param capacity   The size of the arena in bytes
+      @param hugePages  Whether to back the arena with huge pages, where
+                        the system has them
+    */
+    EnvArena(uInt32 capacity, bool hugePages = false);
+
+    /**
+      Destructor; every object in the arena must have been freed
+    */
+    ~EnvArena();
+
+    /**
+      Makes an arena current on this thread for as long as it exists.
+    */
+    class Scope
+    {
+      public:
+        Scope(EnvArena* arena);
+        ~Scope();
+
+      private:
+        EnvArena* myPrevious;
+    };
+
+  public:
+    /**
+      Allocate memory from the current arena, or from the heap if there is
+      no current arena or it is full.
+
+      @param size  The number of bytes needed
+      @return  Memory aligned for any type
+    */
+    static void* allocate(size_t size);
+
+    /**
+      Free memory returned by allocate, whichever arena or thread it came
+      from.
+
+      @param p  The memory to free (may be NULL)
+    */
+    static void release(void* p);
+
+    /**
+      Get the number of bytes handed out so far
+    */
+    uInt32 used() const { return myUsed; }
+
+    /**
+      Get the size of the arena, which huge pages may have rounded up
+    */
+    uInt32 capacity() const { return myCapacity; }
+
+    /**
+      Answer whether the arena was created with the given arguments
+    */
+    bool createdWith(uInt32 capacity, bool hugePages) const
+    {
+      return capacity == myRequestedCapacity && hugePages == myRequestedHugePages;
+    }
+
+    /**
+      Answer whether the arena is backed by huge pages
+    */
+    bool hugePages() const { return myHugePages; }
+
+  private:
+    // Copy constructor and assignment operator aren't supported
+    EnvArena(const EnvArena&);
+    EnvArena& operator = (const EnvArena&);
+
+  private:
+    // The memory of the arena
+    uInt8* myBase;
+
+    // The size of the arena
+    uInt32 myCapacity;
+
+    // The arguments the arena was created with
+    uInt32 myRequestedCapacity;
+    bool myRequestedHugePages;
+
+    // Number of bytes handed out
+    uInt32 myUsed;
+
+    // Number of allocations not freed yet
+    uInt32 myLive;
+
+    // Indicates if the arena was mapped rather than taken from the heap
+    bool myMapped;
+
+    // Indicates if the mapping is backed by huge pages
+    bool myHugePages;
+};
+
+/**
+  Declares the operators which place objects of a class in the current
+  arena.  Objects of the class can then no longer be created with
+  placement new.
+*/
+#define ENV_ARENA_ALLOCATED \
+    static void* operator new(size_t size) { return EnvArena::allocate(size); } \
+    static void operator delete(void* p) { EnvArena::release(p); }
+
+#endif
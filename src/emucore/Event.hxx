@@ -20,6 +20,7 @@
 #define EVENT_HXX
 
 #include "m6502/src/bspf/src/bspf.hxx"
+#include "EnvArena.hxx"
 
 class Event;
 class EventStreamer;
@@ -31,6 +32,8 @@ class EventStreamer;
 class Event
 {
   public:
+    ENV_ARENA_ALLOCATED
+
     /**
       Enumeration of all possible events in Stella, including both
       console and controller event types as well as events that aren't
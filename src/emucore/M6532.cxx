@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <assert.h>
+#include <string.h>
 #include "Console.hxx"
 #include "M6532.hxx"
 #include "Random.hxx"
@@ -28,7 +29,8 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6532::M6532(const Console& console)
-    : myConsole(console)
+    : myConsole(console),
+      myTrackRAMWrites(false)
 {
   class Random random;
 
@@ -39,6 +41,9 @@ M6532::M6532(const Console& console)
     myRAM[t] = random.next();
   }
 
+  clearRAMChanges();
+  clearRAMWriteCounts();
+
   // Initialize other data members
   reset();
 }
@@ -102,8 +107,9 @@ void M6532::install(System& system)
     {
       if((address & 0x0200) == 0x0000)
       {
+        // Recorded writes have to go through poke
         access.directPeekBase = &myRAM[address & 0x007f];
-        access.directPokeBase = &myRAM[address & 0x007f];
+        access.directPokeBase = myTrackRAMWrites ? 0 : &myRAM[address & 0x007f];
         mySystem->setPageAccess(address >> shift, access);
       }
       else
@@ -222,7 +228,15 @@ uInt8 M6532::peek(uInt16 addr)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6532::poke(uInt16 addr, uInt8 value)
 {
-  if((addr & 0x07) == 0x00)         // Port A I/O Register (Joystick)
+  if((addr & 0x0200) == 0x0000)     // RAM, when writes are recorded
+  {
+    uInt32 i = addr & 0x007f;
+    if(myRAM[i] != value)
+      myRAMChanges[i >> 5] |= 1u << (i & 0x1f);
+    ++myRAMWriteCounts[i];
+    myRAM[i] = value;
+  }
+  else if((addr & 0x07) == 0x00)    // Port A I/O Register (Joystick)
   {
     uInt8 a = value & myDDRA;
 
@@ -321,6 +335,28 @@ void M6532::poke(uInt16 addr, uInt8 value)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::trackRAMWrites(bool track)
+{
+  myTrackRAMWrites = track;
+
+  // Reinstall so that RAM pages are poked directly, or not
+  if(mySystem != 0)
+    install(*mySystem);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::clearRAMChanges()
+{
+  memset(myRAMChanges, 0, sizeof(myRAMChanges));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::clearRAMWriteCounts()
+{
+  memset(myRAMWriteCounts, 0, sizeof(myRAMWriteCounts));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6532::save(Serializer& out)
 {
@@ -380,6 +416,10 @@ bool M6532::load(Deserializer& in)
 
     myDDRA = (uInt8) in.getInt();
     myDDRB = (uInt8) in.getInt();
+
+    // All of the RAM may have changed
+    if(myTrackRAMWrites)
+      memset(myRAMChanges, 0xff, sizeof(myRAMChanges));
   }
   catch(char *msg)
   {
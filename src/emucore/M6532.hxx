@@ -109,6 +109,49 @@ class M6532 : public Device
     */
     virtual void poke(uInt16 address, uInt8 value);
 
+  public:
+    /**
+      Enable or disable the recording of RAM writes.  While enabled, RAM
+      writes go through poke rather than straight to memory, which is
+      slower, so this is off by default.
+
+      @param track Whether RAM writes should be recorded
+    */
+    void trackRAMWrites(bool track);
+
+    /**
+      Answer whether RAM writes are being recorded
+    */
+    bool tracksRAMWrites() const { return myTrackRAMWrites; }
+
+    /**
+      Get the RAM bytes whose value changed since clearRAMChanges was last
+      called, as a 128 bit mask: bit (i & 31) of word (i >> 5) is set if
+      byte i (address 0x80 + i) changed.  Loading a state marks every byte.
+
+      @return The four words of the mask
+    */
+    const uInt32* ramChanges() const { return myRAMChanges; }
+
+    /**
+      Clear the mask of changed RAM bytes, e.g. at the start of a frame
+    */
+    void clearRAMChanges();
+
+    /**
+      Get the number of writes to each RAM byte, whether or not they
+      changed its value, since clearRAMWriteCounts was last called.  The
+      counts are not part of the saved state.
+
+      @return The 128 counters
+    */
+    const uInt32* ramWriteCounts() const { return myRAMWriteCounts; }
+
+    /**
+      Zero the RAM write counters
+    */
+    void clearRAMWriteCounts();
+
   private:
     // Reference to the console
     const Console& myConsole;
@@ -137,6 +180,15 @@ class M6532 : public Device
     // Data Direction Register for Port B
     uInt8 myDDRB;
 
+    // Indicates if RAM writes are recorded in the two tables below
+    bool myTrackRAMWrites;
+
+    // Mask of the RAM bytes changed since it was last cleared
+    uInt32 myRAMChanges[4];
+
+    // Number of writes to each RAM byte since they were last cleared
+    uInt32 myRAMWriteCounts[128];
+
   private:
     // Copy constructor isn't supported by this class so make it private
     M6532(const M6532&);
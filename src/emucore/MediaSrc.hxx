@@ -67,6 +67,16 @@ class MediaSource
     */
     virtual uInt8* previousFrameBuffer() const = 0;
 
+    /**
+      Answers which scanlines of the current frame buffer differ from the
+      previous frame buffer, one entry per line of height(). The entries
+      are computed when a frame is completed; anyone who writes into the
+      frame buffers directly should update them as well.
+
+      @return Pointer to the per-scanline change flags (non-zero if changed)
+    */
+    virtual uInt8* scanlineChanges() const = 0;
+
 #ifdef DEBUGGER_SUPPORT
     /**
       This method should be called whenever a new scanline is to be drawn.
@@ -38,6 +38,7 @@
 #include "MD5.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "ROMImage.hxx"
 //ALE   #include "EventHandler.hxx"
 #include "Event.hxx"            //ALE 
 #include "EventStreamer.hxx"
@@ -71,6 +72,7 @@ OSystem::OSystem()
     mySettings(NULL),
     myPropSet(NULL),
     myConsole(NULL),
+    myROMImage(NULL),
     //ALE  myMenu(NULL),
     //ALE  myCommandMenu(NULL),
     //ALE  myLauncher(NULL),
@@ -374,16 +376,15 @@ bool OSystem::createConsole(const string& romfile)
   else
     myRomFile = romfile;
 
-  // Open the cartridge image and read it in
-  uInt8* image;
-  int size = -1;
+  // Open the cartridge image; it is kept until the console is deleted,
+  // since the cartridge points into it
   string md5;
-  if(openROM(myRomFile, md5, &image, &size))
+  if(openROM(myRomFile, md5, &myROMImage))
   {
     // Get all required info for creating a valid console
     Cartridge* cart = (Cartridge*) NULL;
     Properties props;
-    if(queryConsoleInfo(image, size, md5, &cart, props))
+    if(queryConsoleInfo(myROMImage->image(), myROMImage->size(), md5, &cart, props))
     {
       // Create an instance of the 2600 game console
       myConsole = new Console(this, cart, props);
@@ -414,6 +415,8 @@ bool OSystem::createConsole(const string& romfile)
     else
     {
       cerr << "ERROR: Couldn't create console for " << myRomFile << " ..." << endl;
+      ROMImage::release(myROMImage);
+      myROMImage = NULL;
       retval = false;
     }
   }
@@ -423,10 +426,6 @@ bool OSystem::createConsole(const string& romfile)
     retval = false;
   }
 
-  // Free the image since we don't need it any longer
-  if(size != -1) {
-    delete[] image;
-  }
   p_export_screen = new ExportScreen(this); //ALE 
 
   if (mySettings->getBool("display_screen", true)) {
@@ -464,6 +463,8 @@ void OSystem::deleteConsole()
     // }
     delete myConsole;  
     myConsole = NULL;
+    ROMImage::release(myROMImage);
+    myROMImage = NULL;
   }
   if (p_export_screen) {        //ALE 
     delete p_export_screen;     //ALE 
@@ -487,8 +488,21 @@ void OSystem::createLauncher()
 ALE */
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool OSystem::openROM(const string& rom, string& md5, uInt8** image, int* size)
+bool OSystem::openROM(const string& rom, string& md5, ROMImage** image)
 {
+  // A ROM file which has been opened before is neither read nor hashed
+  // again; its properties were resolved (and cached in ourKnownROMs) the
+  // first time around
+  *image = ROMImage::acquire(rom);
+  if(*image != NULL)
+  {
+    md5 = (*image)->md5();
+    return true;
+  }
+
+  uInt8* data;
+  int size;
+
   // Try to open the file as a zipped archive
   // If that fails, we assume it's just a gzipped or normal data file
   unzFile tz;
@@ -527,14 +541,14 @@ bool OSystem::openROM(const string& rom, string& md5, uInt8** image, int* size)
         unzClose(tz);
         return false;
       }
-      *size  = ufo.uncompressed_size;
-      *image = new uInt8[*size];
+      size = ufo.uncompressed_size;
+      data = new uInt8[size];
 
       // We don't have to check for any return errors from these functions,
-      // since if there are, 'image' will not contain a valid ROM and the
+      // since if there are, 'data' will not contain a valid ROM and the
       // calling method can take of it
       unzOpenCurrentFile(tz);
-      unzReadCurrentFile(tz, *image, *size);
+      unzReadCurrentFile(tz, data, size);
       unzCloseCurrentFile(tz);
       unzClose(tz);
     }
@@ -551,14 +565,21 @@ bool OSystem::openROM(const string& rom, string& md5, uInt8** image, int* size)
     if(!f)
       return false;
 
-    *image = new uInt8[MAX_ROM_SIZE];
-    *size = gzread(f, *image, MAX_ROM_SIZE);
+    data = new uInt8[MAX_ROM_SIZE];
+    size = gzread(f, data, MAX_ROM_SIZE);
     gzclose(f);
+    if(size < 0)
+    {
+      delete[] data;
+      return false;
+    }
   }
 
   // If we get to this point, we know we have a valid file to open
   // Now we make sure that the file has a valid properties entry
-  md5 = MD5(*image, *size);
+  md5 = MD5(data, size);
+  *image = ROMImage::insert(rom, data, size, md5);
+  delete[] data;
 
   // Some games may not have a name, since there may not
   // be an entry in stella.pro.  In that case, we use the rom name
@@ -588,16 +609,15 @@ string OSystem::getROMInfo(const string& romfile)
 {
   ostringstream buf;
 
-  // Open the cartridge image and read it in
-  uInt8* image;
-  int size = -1;
+  // Open the cartridge image
+  ROMImage* rom = NULL;
   string md5;
-  if(openROM(romfile, md5, &image, &size))
+  if(openROM(romfile, md5, &rom))
   {
     // Get all required info for creating a temporary console
     Cartridge* cart = (Cartridge*) NULL;
     Properties props;
-    if(queryConsoleInfo(image, size, md5, &cart, props))
+    if(queryConsoleInfo(rom->image(), rom->size(), md5, &cart, props))
     {
       Console* console = new Console(this, cart, props);
       if(console)
@@ -610,9 +630,8 @@ string OSystem::getROMInfo(const string& romfile)
     else
       buf << "ERROR: Couldn't open " << romfile << " ..." << endl;
   }
-  // Free the image and console since we don't need it any longer
-  if(size != -1)
-    delete[] image;
+  // Release the image since we don't need it any longer
+  ROMImage::release(rom);
 
   return buf.str();
 }
@@ -624,8 +643,20 @@ bool OSystem::queryConsoleInfo(const uInt8* image, uInt32 size,
 {
   // Get a valid set of properties, including any entered on the commandline
   string s;
-  myPropSet->getMD5(md5, props);
-
+  {
+    // Consoles may be created from several threads at once
+    boost::mutex::scoped_lock lock(ourKnownROMsMutex);
+    map<string, Properties>::const_iterator known = ourKnownROMs.find(md5);
+    if(known != ourKnownROMs.end())
+      props = known->second;
+    else
+    {
+      myPropSet->getMD5(md5, props);
+      if(props.get(Cartridge_Type) == "AUTO-DETECT")
+        props.set(Cartridge_Type, Cartridge::autodetectType(image, size));
+      ourKnownROMs[md5] = props;
+    }
+  }
 
     s = mySettings->getString("type");
     if(s != "") props.set(Cartridge_Type, s);
@@ -670,6 +701,10 @@ bool OSystem::queryConsoleInfo(const uInt8* image, uInt32 size,
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+map<string, Properties> OSystem::ourKnownROMs;
+boost::mutex OSystem::ourKnownROMsMutex;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystem::resetLoopTiming()
 {
@@ -27,6 +27,9 @@ class Launcher;
 class Debugger;
 class CheatManager;
 class VideoDialog;
+class ROMImage;
+#include <map>
+#include <boost/thread/mutex.hpp>
 #include "../common/Array.hxx"
 //ALE  #include "EventHandler.hxx"
 //ALE  #include "FrameBuffer.hxx"
@@ -331,16 +334,16 @@ class OSystem
     const string& features() const { return myFeatures; }
 
     /**
-      Open the given ROM and return an array containing its contents.
+      Open the given ROM and return the shared image of its contents.
+      The file is only read the first time it is opened.
 
       @param rom    The absolute pathname of the ROM file
       @param md5    The md5 calculated from the ROM file
-      @param image  A pointer to store the ROM data
-                    Note, the calling method is responsible for deleting this
-      @param size   The amount of data read into the image array
+      @param image  A pointer to store the ROM image
+                    Note, the calling method is responsible for releasing this
       @return  False on any errors, else true
     */
-    bool openROM(const string& rom, string& md5, uInt8** image, int* size);
+    bool openROM(const string& rom, string& md5, ROMImage** image);
 
     /**
       Issue a quit event to the OSystem.
@@ -466,6 +469,9 @@ class OSystem
 
     // Pointer to the (currently defined) Console object
     Console* myConsole;
+
+    // The ROM image the console's cartridge points into
+    ROMImage* myROMImage;
     
 
     
@@ -570,6 +576,12 @@ class OSystem
     bool queryConsoleInfo(const uInt8* image, uInt32 size, const string& md5,
                           Cartridge** cart, Properties& props);
 
+    // Properties (with the cartridge type already auto-detected) of every
+    // ROM opened so far in this process, keyed by md5.  Creating another
+    // console for one of these skips the properties lookup and detection.
+    static map<string, Properties> ourKnownROMs;
+    static boost::mutex ourKnownROMsMutex;
+
     /**
       Initializes the timing so that the mainloop is reset to its
       initial values.
@@ -22,6 +22,7 @@
 #include "OSystem.hxx"
 #include "GuiUtils.hxx"
 #include "DefProps.hxx"
+#include "DefPropsHash.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
 #include "bspf.hxx"
@@ -77,28 +78,21 @@ void PropertiesSet::getMD5(const string& md5, Properties& properties,
       properties = *(current->props);
   }
 
-  // Otherwise, search the internal database using binary search
-  if(!found)
+  // Otherwise, look in the internal database using its perfect hash
+  if(!found && md5.length() == 32)
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
+    const char* key = md5.c_str();
+    uInt32 bucket = hashBucket(key, DEF_PROPS_HASH_BUCKETS);
+    uInt32 slot = hashSlot(key, DefPropsHashDisplacement[bucket],
+                           DEF_PROPS_HASH_SIZE);
+    int i = DefPropsHashSlot[slot];
+
+    if(i != DEF_PROPS_HASH_EMPTY &&
+       strncmp(key, DefProps[i][Cartridge_MD5], 32) == 0)  // found it
     {
-      int i = (low + high) / 2;
-      int cmp = strncmp(md5.c_str(), DefProps[i][Cartridge_MD5], 32);
-
-      if(cmp == 0)  // found it
-      {
-        for(int p = 0; p < LastPropType; ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set((PropertyType)p, DefProps[i][p]);
-
-        found = true;
-        break;
-      }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
+      for(int p = 0; p < LastPropType; ++p)
+        if(DefProps[i][p][0] != 0)
+          properties.set((PropertyType)p, DefProps[i][p]);
     }
   }
 }
@@ -111,6 +111,49 @@ class PropertiesSet
     */
     void print() const;
 
+    /**
+      Hash function used by the perfect hash over the built-in properties
+      (see DefPropsHash.hxx).  The md5 is already uniformly distributed,
+      so two of its 32-bit words and the bucket's displacement suffice.
+
+      @param md5           The (lowercase hex) md5 to hash
+      @param displacement  The displacement value of the md5's bucket
+      @param tableSize     The number of slots in the hash table
+      @return  The slot to look in for the given md5
+    */
+    static uInt32 hashSlot(const char* md5, uInt32 displacement,
+                           uInt32 tableSize)
+    {
+      uInt32 h = hexWord(md5 + 8) ^ (displacement * 0x9E3779B1);
+      h ^= h >> 16;
+      return (h * 0x85EBCA6B + hexWord(md5 + 16)) % tableSize;
+    }
+
+    /**
+      Answers the bucket of the given md5 in the perfect hash.
+    */
+    static uInt32 hashBucket(const char* md5, uInt32 numBuckets)
+    {
+      return hexWord(md5) % numBuckets;
+    }
+
+  private:
+    /**
+      Converts 8 hex digits to a 32-bit word (non-hex digits count as 0).
+    */
+    static uInt32 hexWord(const char* hex)
+    {
+      uInt32 w = 0;
+      for(int i = 0; i < 8; ++i)
+      {
+        char c = hex[i];
+        uInt32 v = (c >= '0' && c <= '9') ? c - '0' :
+                   (c >= 'a' && c <= 'f') ? c - 'a' + 10 : 0;
+        w = (w << 4) | v;
+      }
+      return w;
+    }
+
   private:
     struct TreeNode {
       Properties* props;
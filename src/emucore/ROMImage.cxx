@@ -0,0 +1,92 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+//============================================================================
+
+#include <string.h>
+
+#include "ROMImage.hxx"
+
+// Some cartridge types read a fixed amount of data whatever the size of the
+// file, so images are padded with zeros up to the largest such amount
+#define MIN_IMAGE_SIZE 65536
+
+map<string, ROMImage*> ROMImage::ourImages;
+map<string, string> ROMImage::ourFiles;
+boost::mutex ROMImage::ourMutex;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ROMImage::ROMImage(const uInt8* data, uInt32 size, const string& md5)
+  : mySize(size),
+    myMD5(md5),
+    myRefCount(0)
+{
+  uInt32 allocated = BSPF_max(mySize, (uInt32)MIN_IMAGE_SIZE);
+  myImage = new uInt8[allocated];
+  memcpy(myImage, data, mySize);
+  memset(myImage + mySize, 0, allocated - mySize);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ROMImage::~ROMImage()
+{
+  delete[] myImage;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ROMImage* ROMImage::acquire(const string& filename)
+{
+  boost::mutex::scoped_lock lock(ourMutex);
+  map<string, string>::const_iterator file = ourFiles.find(filename);
+  if(file == ourFiles.end())
+    return NULL;
+
+  // The image may have been freed since the file was read
+  map<string, ROMImage*>::iterator rom = ourImages.find(file->second);
+  if(rom == ourImages.end())
+    return NULL;
+
+  rom->second->myRefCount++;
+  return rom->second;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ROMImage* ROMImage::insert(const string& filename, const uInt8* data,
+                           uInt32 size, const string& md5)
+{
+  boost::mutex::scoped_lock lock(ourMutex);
+  ourFiles[filename] = md5;
+
+  ROMImage*& rom = ourImages[md5];
+  if(rom == NULL)
+    rom = new ROMImage(data, size, md5);
+
+  rom->myRefCount++;
+  return rom;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ROMImage::release(ROMImage* rom)
+{
+  if(rom == NULL)
+    return;
+
+  boost::mutex::scoped_lock lock(ourMutex);
+  if(--rom->myRefCount > 0)
+    return;
+
+  ourImages.erase(rom->myMD5);
+  delete rom;
+}
@@ -0,0 +1,120 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+//============================================================================
+
+#ifndef ROMIMAGE_HXX
+#define ROMIMAGE_HXX
+
+#include <map>
+#include <boost/thread/mutex.hpp>
+
+#include "m6502/src/bspf/src/bspf.hxx"
+
+/**
+  An immutable ROM image, shared by every console in the process which
+  runs the same ROM.  Cartridges point into the image instead of copying
+  it; anything a cartridge writes to (bankswitch RAM) stays in the
+  cartridge.
+
+  Images are kept by MD5, and the file each image was read from is
+  remembered, so that opening the same ROM file a second time neither
+  reads nor hashes it again.  An image is freed when the last console
+  using it releases it.
+
+  The cache is guarded by a mutex, so consoles may be created and
+  destroyed on several threads at once.
+*/
+class ROMImage
+{
+  public:
+    /**
+      Get the image previously read from the given file, adding a
+      reference to it.
+
+      @param filename  The ROM file
+      @return  The shared image, or NULL if the file hasn't been read yet
+    */
+    static ROMImage* acquire(const string& filename);
+
+    /**
+      Add an image which was just read from the given file, adding a
+      reference to it.  If an image with the same MD5 already exists
+      it is shared instead.
+
+      @param filename  The ROM file the data was read from
+      @param data      The ROM data; it is copied
+      @param size      The size of the ROM data
+      @param md5       The MD5 of the ROM data
+      @return  The shared image
+    */
+    static ROMImage* insert(const string& filename, const uInt8* data,
+                            uInt32 size, const string& md5);
+
+    /**
+      Drop a reference to the image, freeing it when nothing uses it.
+
+      @param rom  The image to release (may be NULL)
+    */
+    static void release(ROMImage* rom);
+
+  public:
+    /**
+      Get the ROM data.
+    */
+    const uInt8* image() const { return myImage; }
+
+    /**
+      Get the size of the ROM data.
+    */
+    uInt32 size() const { return mySize; }
+
+    /**
+      Get the MD5 of the ROM data.
+    */
+    const string& md5() const { return myMD5; }
+
+  private:
+    ROMImage(const uInt8* data, uInt32 size, const string& md5);
+    ~ROMImage();
+
+    // Copy constructor and assignment operator aren't supported
+    ROMImage(const ROMImage&);
+    ROMImage& operator = (const ROMImage&);
+
+  private:
+    // The ROM data
+    uInt8* myImage;
+
+    // The size of the ROM data
+    uInt32 mySize;
+
+    // The MD5 of the ROM data
+    string myMD5;
+
+    // Number of consoles using this image
+    uInt32 myRefCount;
+
+    // The shared images, indexed by MD5
+    static map<string, ROMImage*> ourImages;
+
+    // The MD5 of every ROM file read so far, indexed by filename
+    static map<string, string> ourFiles;
+
+    // Guards the two maps above and the reference counts
+    static boost::mutex ourMutex;
+};
+
+#endif
@@ -16,12 +16,23 @@
 // $Id: Serializer.cxx,v 1.11 2007/01/01 18:04:49 stephena Exp $
 //============================================================================
 
+#include <cstring>
 #include "Serializer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Serializer::Serializer(void) {
-    myStream.clear();
-    
+Serializer::Serializer(bool compact):
+    myCompact(compact),
+    myBuffer(NULL),
+    myCapacity(0),
+    mySize(0) {
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(uInt8* buffer, uInt32 capacity, bool compact):
+    myCompact(compact),
+    myBuffer(buffer),
+    myCapacity(capacity),
+    mySize(0) {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -34,20 +45,52 @@ Serializer::~Serializer(void)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::close(void)
 {
-    myStream.clear();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::write(const void* data, uInt32 length)
+{
+    if(myBuffer == NULL)
+    {
+        myString.append((const char*)data, length);
+        return;
+    }
+
+    if(length > myCapacity - mySize)
+        throw "Serializer: buffer full";
+    memcpy(myBuffer + mySize, data, length);
+    mySize += length;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::putVarint(uInt32 value)
+{
+    unsigned char buf[5];
+    int length = 0;
+    while(value >= 0x80)
+    {
+        buf[length++] = (value & 0x7f) | 0x80;
+        value >>= 7;
+    }
+    buf[length++] = value;
+    write(buf, length);
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putInt(int value)
 {
+    if(myCompact)
+    {
+        putVarint((uInt32)value);
+        return;
+    }
+
     unsigned char buf[4];
     for(int i = 0; i < 4; ++i)
         buf[i] = (value >> (i<<3)) & 0xff;
     
-    myStream.write((char*)buf, 4);
-    if(myStream.bad())
-        throw "Serializer: file write failed";
+    write(buf, 4);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -55,15 +98,32 @@ void Serializer::putString(const string& str)
 {
     int len = str.length();
     putInt(len);
-    myStream.write(str.data(), (streamsize)len);
-    
-    if(myStream.bad())
-        throw "Serializer: file write failed";
+    write(str.data(), len);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putBool(bool b)
 {
+    if(myCompact)
+    {
+        unsigned char byte = b ? 1 : 0;
+        write(&byte, 1);
+        return;
+    }
+
     putInt(b ? TruePattern: FalsePattern);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::putDouble(double value)
+{
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    unsigned char buf[8];
+    for(int i = 0; i < 8; ++i)
+        buf[i] = (bits >> (i<<3)) & 0xff;
+
+    write(buf, 8);
+}
+
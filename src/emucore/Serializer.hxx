@@ -19,7 +19,6 @@
 #ifndef SERIALIZER_HXX
 #define SERIALIZER_HXX
 
-#include <sstream>
 #include "m6502/src/bspf/src/bspf.hxx"
 
 /**
@@ -36,6 +35,14 @@
   
   Revised for ALE on Sep 20, 2009
   The new version uses a stringstream (not a file stream)
+
+  The data now goes either to a string owned by the Serializer, or to a
+  fixed buffer given by the caller, which is never reallocated; writing
+  past the end of that buffer throws.
+
+  In compact mode ints and string lengths are written as unsigned LEB128
+  varints (one byte below 128, at most five) and booleans as one byte,
+  so that the output is small and does not depend on the host.
 */
 class Serializer
 {
@@ -43,8 +50,18 @@ class Serializer
     /**
       Creates a new Serializer device.
 
+      @param compact Whether to use the compact encoding
     */
-    Serializer(void);
+    Serializer(bool compact = false);
+
+    /**
+      Creates a new Serializer device writing into the given buffer.
+
+      @param buffer   The buffer to write to; it must outlive the Serializer
+      @param capacity The size of the buffer, in bytes
+      @param compact  Whether to use the compact encoding
+    */
+    Serializer(uInt8* buffer, uInt32 capacity, bool compact = false);
 
     /**
       Destructor
@@ -80,14 +97,38 @@ class Serializer
     */
     void putBool(bool b);
 
-    // Accessor for myStream
-    // TODO: don't copy the whole streams. 
+    /**
+      Writes a double value to the current output stream, as the eight
+      bytes of its IEEE 754 encoding, least significant first.
+
+      @param value The double value to write to the output stream.
+    */
+    void putDouble(double value);
+
+    // A copy of the data written so far
     string get_str(void) const {
-        return myStream.str();
+        return myBuffer != NULL ? string((const char*)myBuffer, mySize) : myString;
+    }
+
+    // The number of bytes written so far
+    uInt32 size(void) const {
+        return myBuffer != NULL ? mySize : myString.size();
     }
+
   private:
-    // The stream to send the serialized data to.
-    stringstream myStream;
+    void write(const void* data, uInt32 length);
+    void putVarint(uInt32 value);
+
+  private:
+    bool myCompact;
+
+    // The data, when no buffer was given
+    string myString;
+
+    // The caller's buffer, its capacity and the bytes used in it
+    uInt8* myBuffer;
+    uInt32 myCapacity;
+    uInt32 mySize;
 
     enum {
       TruePattern  = 0xfab1fab2,
@@ -269,11 +269,37 @@ void Settings::usage() {
     << endl
     << endl
     << " * Valid options are:" << endl
-    << " *  -game_controller [internal]/[fifo]" << endl 
+    << " *  -game_controller [internal]/[fifo]/[server]" << endl 
     << " *   Defines how Stella communicates with the player agent:"                   << endl
     << " *           - 'internal': (default) an instance of the PlayerAgent"             << endl 
     << " *                        subclass controls the game"     << endl
     << " *           - 'fifo':    Control occurs through FIFO pipes "<< endl
+    << " *           - 'server':  The ROM is loaded once and a warm copy is"<< endl
+    << " *                        forked for every agent connecting to"<< endl
+    << " *                        the Unix socket -server_socket"<< endl
+    << endl
+    << " *  -pipelined_fifo [true]/[false]"                                               << endl
+    << " *   Talk to a FIFO agent from a separate I/O thread, and emulate the"            << endl
+    << " *   next frame for the agent's last action while it is thinking."                << endl
+    << " *   Uses an extra core. Default is false."                                       << endl
+    << endl
+    << " *  -player_agent [random_agent]/[single_action_agent]/[uct]"                    << endl
+    << " *   The agent playing under the internal controller. 'uct' searches"            << endl
+    << " *   -uct_simulations (default 500) playouts of up to -uct_depth (100)"           << endl
+    << " *   decisions before each decision, split over -uct_threads (1) copies"          << endl
+    << " *   of the emulator. A decision lasts 1 + -uct_frame_skip (4) frames;"           << endl
+    << " *   -uct_exploration (0.1) weighs the UCB bonus. Reports the search"             << endl
+    << " *   speed and memory use after each episode."                                    << endl
+    << endl
+    << " *  -record_dataset file"                                                         << endl
+    << " *   Streams every step (screen, RAM, action, reward and episode ends)"          << endl
+    << " *   to the given file from a background thread. Screens are stored as"           << endl
+    << " *   deltas, with a full screen every -dataset_keyframe_interval steps"           << endl
+    << " *   (default 64). Used by the internal controller and ALEInterface."             << endl
+    << endl
+    << " *  -track_ram_writes [true]/[false]"                                             << endl
+    << " *   Record which RAM bytes change on each step, and how often each byte"         << endl
+    << " *   is written, for agents to use. RAM writes are slower. Default false."        << endl
     << endl
     << " *  -random_seed  [time]/[n] "                                                      << endl
     << " *  Sets the seed used for random number generation. "                         << endl 
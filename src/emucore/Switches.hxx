@@ -24,6 +24,7 @@ class Properties;
 class Switches;
 
 #include "m6502/src/bspf/src/bspf.hxx"
+#include "EnvArena.hxx"
 
 /**
   This class represents the console switches of the game console.
@@ -34,6 +35,8 @@ class Switches;
 class Switches
 {
   public:
+    ENV_ARENA_ALLOCATED
+
     /**
       Create a new set of switches using the specified events and
       properties
@@ -148,6 +148,14 @@ class TIA : public Device , public MediaSource
     */
     uInt8* previousFrameBuffer() const { return myPreviousFrameBuffer; }
 
+    /**
+      Answers which scanlines changed between the previous and the current
+      frame buffer
+
+      @return Pointer to the per-scanline change flags
+    */
+    uInt8* scanlineChanges() const { return myScanlineChanges; }
+
     /**
       Answers the height of the frame buffer
 
@@ -233,28 +241,6 @@ class TIA : public Device , public MediaSource
     virtual void updateScanlineByTrace(int target);
 #endif
 
-  private:
-    // Compute the ball mask table
-    void computeBallMaskTable();
-
-    // Compute the collision decode table
-    void computeCollisionTable();
-
-    // Compute the missle mask table
-    void computeMissleMaskTable();
-
-    // Compute the player mask table
-    void computePlayerMaskTable();
-
-    // Compute the player position reset when table
-    void computePlayerPositionResetWhenTable();
-
-    // Compute the player reflect table
-    void computePlayerReflectTable();
-
-    // Compute playfield mask table
-    void computePlayfieldMaskTable();
-
   private:
     // Update the current frame buffer up to one scanline
     void updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos);
@@ -277,6 +263,9 @@ class TIA : public Device , public MediaSource
     // Update bookkeeping at end of frame
     void endFrame();
 
+    // Compare each scanline of the current and previous frame buffers
+    void updateScanlineChanges();
+
   private:
     // Console the TIA is associated with
     const Console& myConsole;
@@ -307,6 +296,9 @@ class TIA : public Device , public MediaSource
     // Pointer to the previous frame buffer
     uInt8* myPreviousFrameBuffer;
 
+    // One flag per scanline, set if it differs between the two frame buffers
+    uInt8* myScanlineChanges;
+
     // Pointer to the next pixel that will be drawn in the current frame buffer
     uInt8* myFramePointer;
 
@@ -455,22 +447,22 @@ class TIA : public Device , public MediaSource
     // the TIA code will fail on a good number of CPUs.
 
     // Pointer to the currently active mask array for the ball
-    uInt8* myCurrentBLMask;
+    const uInt8* myCurrentBLMask;
 
     // Pointer to the currently active mask array for missle 0
-    uInt8* myCurrentM0Mask;
+    const uInt8* myCurrentM0Mask;
 
     // Pointer to the currently active mask array for missle 1
-    uInt8* myCurrentM1Mask;
+    const uInt8* myCurrentM1Mask;
 
     // Pointer to the currently active mask array for player 0
-    uInt8* myCurrentP0Mask;
+    const uInt8* myCurrentP0Mask;
 
     // Pointer to the currently active mask array for player 1
-    uInt8* myCurrentP1Mask;
+    const uInt8* myCurrentP1Mask;
 
     // Pointer to the currently active mask array for the playfield
-    uInt32* myCurrentPFMask;
+    const uInt32* myCurrentPFMask;
 
     // Audio values. Only used by TIADebug.
     uInt8 myAUDV0;
@@ -511,19 +503,19 @@ class TIA : public Device , public MediaSource
 
   private:
     // Ball mask table (entries are true or false)
-    static uInt8 ourBallMaskTable[4][4][320];
+    static const uInt8 ourBallMaskTable[4][4][320];
 
     // Used to set the collision register to the correct value
-    static uInt16 ourCollisionTable[64];
+    static const uInt16 ourCollisionTable[64];
 
     // A mask table which can be used when an object is disabled
-    static uInt8 ourDisabledMaskTable[640];
+    static const uInt8 ourDisabledMaskTable[640];
 
     // Indicates the update delay associated with poking at a TIA address
     static const Int16 ourPokeDelayTable[64];
 
     // Missle mask table (entries are true or false)
-    static uInt8 ourMissleMaskTable[4][8][4][320];
+    static const uInt8 ourMissleMaskTable[4][8][4][320];
 
     // Used to convert value written in a motion register into 
     // its internal representation
@@ -533,16 +525,16 @@ class TIA : public Device , public MediaSource
     static const bool ourHMOVEBlankEnableCycles[76];
 
     // Player mask table
-    static uInt8 ourPlayerMaskTable[4][2][8][320];
+    static const uInt8 ourPlayerMaskTable[4][2][8][320];
 
     // Indicates if player is being reset during delay, display or other times
-    static Int8 ourPlayerPositionResetWhenTable[8][160][160];
+    static const Int8 ourPlayerPositionResetWhenTable[8][160][160];
 
     // Used to reflect a players graphics
-    static uInt8 ourPlayerReflectTable[256];
+    static const uInt8 ourPlayerReflectTable[256];
 
     // Playfield mask table for reflected and non-reflected playfields
-    static uInt32 ourPlayfieldTable[2][160];
+    static const uInt32 ourPlayfieldTable[2][160];
 
   private:
     // Copy constructor isn't supported by this class so make it private
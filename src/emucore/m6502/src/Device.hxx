@@ -24,6 +24,7 @@ class Serializer;
 class Deserializer;
 
 #include "bspf/src/bspf.hxx"
+#include "../../EnvArena.hxx"
 
 /**
   Abstract base class for devices which can be attached to a 6502
@@ -35,6 +36,8 @@ class Deserializer;
 class Device
 {
   public:
+    ENV_ARENA_ALLOCATED
+
     /**
       Create a new device
     */
@@ -29,6 +29,7 @@ class Expression;
 class PackedBitArray;
 
 #include "bspf/src/bspf.hxx"
+#include "../../EnvArena.hxx"
 #include "System.hxx"
 #include "Array.hxx"
 #ifdef DEBUGGER_SUPPORT
@@ -48,6 +49,8 @@ typedef Common::Array<Expression*> ExpressionList;
 class M6502
 {
   public:
+    ENV_ARENA_ALLOCATED
+
     /**
       The 6502 debugger class is a friend who needs special access
     */
@@ -42,7 +42,7 @@ System::System(uInt16 n, uInt16 m)
   assert((1 <= m) && (m <= n) && (n <= 16));
 
   // Allocate page table
-  myPageAccessTable = new PageAccess[myNumberOfPages];
+  myPageAccessTable = (PageAccess*)EnvArena::allocate(myNumberOfPages * sizeof(PageAccess));
 
   // Initialize page access table
   PageAccess access;
@@ -71,7 +71,7 @@ System::~System()
   delete myM6502;
 
   // Free my page access table
-  delete[] myPageAccessTable;
+  EnvArena::release(myPageAccessTable);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -27,6 +27,7 @@ class Serializer;
 class Deserializer;
 
 #include "bspf/src/bspf.hxx"
+#include "../../EnvArena.hxx"
 #include "Device.hxx"
 #include "NullDev.hxx"
 
@@ -52,6 +53,8 @@ class Deserializer;
 class System
 {
   public:
+    ENV_ARENA_ALLOCATED
+
     /**
       Create a new system with an addressing space of 2^n bytes and
       pages of 2^m bytes.
@@ -282,7 +285,7 @@ class System
         to this page, while other values are the base address of an array 
         to directly access for reads to this page.
       */
-      uInt8* directPeekBase;
+      const uInt8* directPeekBase;
 
       /**
         Pointer to a block of memory or the null pointer.  The null pointer
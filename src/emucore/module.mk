@@ -30,6 +30,7 @@ MODULE_OBJS := \
 	src/emucore/Control.o \
 	src/emucore/Deserializer.o \
 	src/emucore/Driving.o \
+	src/emucore/EnvArena.o \
 	src/emucore/Event.o \
 	src/emucore/FSNode.o \
 	src/emucore/Joystick.o \
@@ -42,6 +43,7 @@ MODULE_OBJS := \
 	src/emucore/Props.o \
 	src/emucore/PropsSet.o \
 	src/emucore/Random.o \
+	src/emucore/ROMImage.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
 	src/emucore/SpeakJet.o \
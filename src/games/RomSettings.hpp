@@ -21,12 +21,15 @@
 #include "../common/Constants.h"
 #include "../emucore/Serializer.hxx"
 #include "../emucore/Deserializer.hxx"
+#include "../emucore/EnvArena.hxx"
 
 class System;
 
 
 // rom support interface
 struct RomSettings {
+    ENV_ARENA_ALLOCATED
+
     virtual ~RomSettings() {}
 
     // reset
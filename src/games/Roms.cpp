@@ -158,3 +158,14 @@ RomSettings *buildRomRLWrapper(const std::string &rom) {
     return NULL;
 }
 
+
+/* titles of all the supported roms */
+std::vector<std::string> supportedRomTitles() {
+
+    std::vector<std::string> titles;
+    for (size_t i=0; i < sizeof(roms)/sizeof(roms[0]); i++) {
+        titles.push_back(roms[i]->rom());
+    }
+
+    return titles;
+}
@@ -34,6 +34,9 @@
 
 #include "control/fifo_controller.h"
 #include "control/internal_controller.h"
+#ifndef WIN32
+#   include "control/server_controller.h"
+#endif
 #include "common/Constants.h"
 
 // ALE Version number
@@ -161,6 +164,17 @@ int main(int argc, char* argv[]) {
         p_game_controller.reset(new FIFOController(theOSystem.get(), true));
         theOSystem->setGameController(p_game_controller.get());
         std::cerr << "Game will be controlled through FIFO pipes." << std::endl;
+#ifndef WIN32
+    } else if (theOSystem->settings().getString("game_controller") == "server") {
+        if (!outputFile.empty()) {
+          cerr << "Cannot redirect stdout when using the server." << endl;
+          return -1;
+        }
+
+        p_game_controller.reset(new ServerController(theOSystem.get()));
+        theOSystem->setGameController(p_game_controller.get());
+        std::cerr << "Games will be forked for agents connecting to the server." << std::endl;
+#endif
     } else if (theOSystem->settings().getString("game_controller") == "internal") {
         p_game_controller.reset(new InternalController(theOSystem.get()));
         theOSystem->setGameController(p_game_controller.get());
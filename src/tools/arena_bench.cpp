@@ -0,0 +1,88 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  arena_bench.cpp
+ *
+ *  Measures the effect of per-environment arenas on memory locality. N
+ *  environments of one ROM are stepped round-robin, one action each in
+ *  turn, as a batched learner does; with many environments their working
+ *  sets no longer fit in the caches, and how they are laid out matters.
+ *  The same run is timed with the emulator objects on the heap, in arenas,
+ *  and in huge-page arenas.
+ *
+ *  Usage: arena_bench rom_file [envs=256] [steps=200] [frame_skip=4]
+ *  Build with 'make -f makefile.unix arenabench'.
+ **************************************************************************** */
+
+#include <cstdio>
+#include <sys/time.h>
+
+#include "../ale_interface.hpp"
+
+static double now() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// Steps every environment num_steps times, round-robin; returns env-steps/sec
+static double run(const string& rom_file, int num_envs, int num_steps, const ALEConfig& config) {
+    // Created together, so that without arenas their objects interleave
+    vector<ALEInterface*> envs(num_envs);
+    for (int e = 0; e < num_envs; e++) {
+        envs[e] = new ALEInterface();
+        if (!envs[e]->loadROM(rom_file, config)) exit(-1);
+    }
+
+    srand(1);
+    double start = now();
+    for (int t = 0; t < num_steps; t++) {
+        for (int e = 0; e < num_envs; e++) {
+            ALEInterface* env = envs[e];
+            env->act(env->allowed_actions[rand() % env->allowed_actions.size()]);
+            if (env->game_over()) env->reset_game();
+        }
+    }
+    double elapsed = now() - start;
+
+    for (int e = 0; e < num_envs; e++)
+        delete envs[e];
+    return (double)num_envs * num_steps / elapsed;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " rom_file [envs] [steps] [frame_skip]" << endl;
+        return -1;
+    }
+    string rom_file = argv[1];
+    int num_envs = argc > 2 ? atoi(argv[2]) : 256;
+    int num_steps = argc > 3 ? atoi(argv[3]) : 200;
+
+    ALEConfig config;
+    config.random_seed = 0;
+    config.max_num_frames = 0;
+    config.frame_skip = argc > 4 ? atoi(argv[4]) : 4;
+    config.observation_mode = OBSERVE_RAM;
+
+    double heap = run(rom_file, num_envs, num_steps, config);
+
+    config.arena_size = 256 << 10;
+    double arena = run(rom_file, num_envs, num_steps, config);
+
+    config.arena_huge_pages = true;
+    double huge = run(rom_file, num_envs, num_steps, config);
+
+    printf("envs %d, steps %d, frame_skip %d\n", num_envs, num_steps, config.frame_skip);
+    printf("heap:             %.0f env-steps/sec\n", heap);
+    printf("arena:            %.0f env-steps/sec (%+.1f%%)\n", arena, 100 * (arena / heap - 1));
+    printf("huge-page arena:  %.0f env-steps/sec (%+.1f%%)\n", huge, 100 * (huge / heap - 1));
+    return 0;
+}
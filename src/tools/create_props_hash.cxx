@@ -0,0 +1,128 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+/**
+  Generates src/emucore/DefPropsHash.hxx, a perfect hash over the md5s of
+  the built-in properties in DefProps.hxx.  Keys are spread over buckets,
+  and each bucket gets the smallest displacement which places all of its
+  keys in free slots (see PropertiesSet::hashSlot).  A lookup is then a
+  single probe plus one md5 comparison.
+
+  Build and run with 'make -f makefile.unix propshash' whenever
+  DefProps.hxx is regenerated.
+*/
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include "../emucore/m6502/src/bspf/src/bspf.hxx"
+#include "../emucore/PropsSet.hxx"
+#include "../emucore/DefProps.hxx"
+
+// Average number of keys per bucket
+#define KEYS_PER_BUCKET 4
+
+// Marks an unused slot in the table
+#define EMPTY_SLOT 0xFFFF
+
+static vector< vector<int> > ourBuckets;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool biggerBucket(uInt32 a, uInt32 b)
+{
+  return ourBuckets[a].size() > ourBuckets[b].size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main()
+{
+  const uInt32 numBuckets = DEF_PROPS_SIZE / KEYS_PER_BUCKET + 1;
+  const uInt32 tableSize  = DEF_PROPS_SIZE + DEF_PROPS_SIZE / 8;
+
+  // Spread the keys over the buckets
+  vector< vector<int> >& buckets = ourBuckets;
+  buckets.resize(numBuckets);
+  for(int i = 0; i < DEF_PROPS_SIZE; ++i)
+  {
+    assert(strlen(DefProps[i][0]) == 32);
+    buckets[PropertiesSet::hashBucket(DefProps[i][0], numBuckets)].push_back(i);
+  }
+
+  // Place the biggest buckets first, since they're the hardest to fit
+  vector<uInt32> order(numBuckets);
+  for(uInt32 b = 0; b < numBuckets; ++b)
+    order[b] = b;
+  stable_sort(order.begin(), order.end(), biggerBucket);
+
+  vector<uInt16> displacement(numBuckets, 0);
+  vector<uInt16> slots(tableSize, EMPTY_SLOT);
+  for(uInt32 b = 0; b < numBuckets; ++b)
+  {
+    const vector<int>& keys = buckets[order[b]];
+    if(keys.empty())
+      continue;
+
+    for(uInt32 d = 0; ; ++d)
+    {
+      assert(d < 0xFFFF);
+      vector<uInt32> placed;
+      bool fits = true;
+      for(uInt32 k = 0; k < keys.size() && fits; ++k)
+      {
+        uInt32 s = PropertiesSet::hashSlot(DefProps[keys[k]][0], d, tableSize);
+        fits = (slots[s] == EMPTY_SLOT) &&
+               find(placed.begin(), placed.end(), s) == placed.end();
+        placed.push_back(s);
+      }
+      if(fits)
+      {
+        for(uInt32 k = 0; k < keys.size(); ++k)
+          slots[placed[k]] = keys[k];
+        displacement[order[b]] = d;
+        break;
+      }
+    }
+  }
+
+  printf("#ifndef DEF_PROPS_HASH_HXX\n");
+  printf("#define DEF_PROPS_HASH_HXX\n\n");
+  printf("/**\n");
+  printf("  This code is generated using the 'create_props_hash' program,\n");
+  printf("  located in the src/tools directory.  It must be regenerated\n");
+  printf("  whenever DefProps.hxx changes.\n");
+  printf("*/\n\n");
+  printf("#define DEF_PROPS_HASH_BUCKETS %u\n", numBuckets);
+  printf("#define DEF_PROPS_HASH_SIZE %u\n", tableSize);
+  printf("#define DEF_PROPS_HASH_EMPTY 0x%04X\n\n", EMPTY_SLOT);
+
+  printf("static const uInt16 DefPropsHashDisplacement[DEF_PROPS_HASH_BUCKETS] = {");
+  for(uInt32 b = 0; b < numBuckets; ++b)
+    printf("%s%u%s", (b % 16) == 0 ? "\n  " : "", displacement[b],
+           b + 1 < numBuckets ? "," : "\n");
+  printf("};\n\n");
+
+  printf("static const uInt16 DefPropsHashSlot[DEF_PROPS_HASH_SIZE] = {");
+  for(uInt32 s = 0; s < tableSize; ++s)
+    printf("%s%u%s", (s % 16) == 0 ? "\n  " : "", slots[s],
+           s + 1 < tableSize ? "," : "\n");
+  printf("};\n\n");
+
+  printf("#endif\n");
+  return 0;
+}
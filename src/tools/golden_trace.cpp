@@ -0,0 +1,257 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  golden_trace.cpp
+ *
+ *  Determinism check for every supported ROM. Each game is played for a
+ *  number of frames with a fixed pseudo-random action script, and a hash of
+ *  the RAM and the screen, the reward and the terminal flag are kept for
+ *  every frame. 'record' writes these to golden_dir/<rom>.golden; 'check'
+ *  compares a new run with them and reports the first frame which differs,
+ *  and what differs in it. Both also check that restoring a snapshot taken
+ *  at a few points of the run reproduces the same frames.
+ *
+ *  Usage: golden_trace record|check rom_dir golden_dir [frames=3000] [rom...]
+ *  ROMs are looked up as rom_dir/<rom>.bin; missing ones are skipped.
+ *  Build with 'make -f makefile.unix goldentrace'.
+ **************************************************************************** */
+
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <zlib.h>
+
+#include "../ale_interface.hpp"
+
+// Frames replayed after each restored snapshot
+static const int ROUND_TRIP_FRAMES = 60;
+// Number of snapshots restored per ROM
+static const int ROUND_TRIPS = 8;
+
+struct FrameHash {
+    uInt32 ram;
+    uInt32 screen;
+    float reward;
+    bool terminal;
+
+    bool operator==(const FrameHash& other) const {
+        return ram == other.ram && screen == other.screen &&
+               reward == other.reward && terminal == other.terminal;
+    }
+    bool operator!=(const FrameHash& other) const { return !(*this == other); }
+};
+
+/* the part of the emulator a mismatch most likely comes from */
+static string describeDifference(const FrameHash& expected, const FrameHash& actual) {
+    string what;
+    if (expected.ram != actual.ram) what += " RAM (CPU/RIOT/cartridge)";
+    if (expected.screen != actual.screen) what += " screen (TIA)";
+    if (expected.reward != actual.reward) what += " reward (RomSettings)";
+    if (expected.terminal != actual.terminal) what += " terminal (RomSettings)";
+    return what;
+}
+
+/* a linear congruential generator, so the script does not depend on rand() */
+class ActionScript {
+    public:
+        ActionScript(const ActionVect& actions): m_actions(actions), i_state(0x5EED), i_hold(0),
+                                                 m_current(PLAYER_A_NOOP) {}
+
+        Action next() {
+            // Actions are held for 1 to 8 frames, as an agent with frame
+            // skipping would
+            if (i_hold == 0) {
+                m_current = m_actions[draw() % m_actions.size()];
+                i_hold = 1 + draw() % 8;
+            }
+            i_hold--;
+            return m_current;
+        }
+
+        uInt32 draw() {
+            i_state = i_state * 1103515245u + 12345u;
+            return i_state >> 16;
+        }
+
+    protected:
+        ActionVect m_actions;
+        uInt32 i_state;
+        int i_hold;
+        Action m_current;
+};
+
+/* takes one action, resetting at the end of the game, and hashes the result */
+static FrameHash step(ALEInterface& ale, Action action) {
+    FrameHash hash;
+    hash.reward = ale.act(action);
+    hash.terminal = ale.game_over();
+
+    uInt8 ram[RAM_LENGTH];
+    for (int i = 0; i < RAM_LENGTH; i++)
+        ram[i] = ale.emulator_system->peek(i + 0x80);
+    hash.ram = crc32(0, ram, RAM_LENGTH);
+    hash.screen = crc32(0, ale.mediasrc->currentFrameBuffer(),
+                        ale.screen_width * ale.screen_height);
+
+    if (hash.terminal) ale.reset_game();
+    return hash;
+}
+
+/* plays the script, checking the snapshot round trips on the way; returns
+   false if one of them failed */
+static bool play(const string& rom_file, int num_frames, vector<FrameHash>& hashes) {
+    ALEConfig config;
+    config.random_seed = 0;
+    config.max_num_frames = 0;
+    config.observation_mode = OBSERVE_NONE;
+
+    ALEInterface ale;
+    if (!ale.loadROM(rom_file, config)) return false;
+
+    ActionScript script(ale.allowed_actions);
+    vector<Action> actions;
+
+    // Frames at which a snapshot is taken, and later restored
+    vector<int> round_trips;
+    for (int i = 0; i < ROUND_TRIPS && num_frames > ROUND_TRIP_FRAMES; i++)
+        round_trips.push_back(script.draw() % (num_frames - ROUND_TRIP_FRAMES));
+    std::sort(round_trips.begin(), round_trips.end());
+
+    bool ok = true;
+    size_t next_round_trip = 0;
+    hashes.clear();
+    for (int f = 0; f < num_frames; f++) {
+        while (next_round_trip < round_trips.size() && round_trips[next_round_trip] == f) {
+            next_round_trip++;
+            string snapshot = ale.saveSnapshot();
+
+            // Play ahead, then go back and check the same frames come out
+            vector<FrameHash> ahead;
+            for (int i = 0; i < ROUND_TRIP_FRAMES; i++) {
+                if (f + i >= (int)actions.size()) actions.push_back(script.next());
+                ahead.push_back(step(ale, actions[f + i]));
+            }
+            ale.restoreSnapshot(snapshot);
+            if (ale.saveSnapshot() != snapshot) {
+                cout << "  frame " << f << ": the restored state saves differently" << endl;
+                ok = false;
+            }
+            for (int i = 0; i < ROUND_TRIP_FRAMES; i++) {
+                FrameHash replayed = step(ale, actions[f + i]);
+                if (replayed != ahead[i]) {
+                    cout << "  frame " << f + i << ": replay from the snapshot of frame "
+                         << f << " differs in" << describeDifference(ahead[i], replayed) << endl;
+                    ok = false;
+                    break;
+                }
+            }
+            ale.restoreSnapshot(snapshot);
+        }
+
+        if (f >= (int)actions.size()) actions.push_back(script.next());
+        hashes.push_back(step(ale, actions[f]));
+    }
+    return ok;
+}
+
+static void writeGolden(const string& filename, const vector<FrameHash>& hashes) {
+    ofstream out(filename.c_str());
+    out << "# frame ram screen reward terminal" << endl;
+    for (size_t f = 0; f < hashes.size(); f++) {
+        char line[64];
+        // Nine digits read back as the same float
+        sprintf(line, "%d %08x %08x %.9g %d", (int)f, hashes[f].ram, hashes[f].screen,
+                hashes[f].reward, hashes[f].terminal ? 1 : 0);
+        out << line << endl;
+    }
+}
+
+static bool readGolden(const string& filename, vector<FrameHash>& hashes) {
+    ifstream in(filename.c_str());
+    if (!in) return false;
+
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        int frame, terminal;
+        FrameHash hash;
+        if (sscanf(line.c_str(), "%d %x %x %f %d", &frame, &hash.ram, &hash.screen,
+                   &hash.reward, &terminal) != 5)
+            return false;
+        hash.terminal = terminal != 0;
+        hashes.push_back(hash);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4 || (string(argv[1]) != "record" && string(argv[1]) != "check")) {
+        cerr << "Usage: " << argv[0] << " record|check rom_dir golden_dir [frames] [rom...]" << endl;
+        return -1;
+    }
+    bool record = string(argv[1]) == "record";
+    string rom_dir = argv[2];
+    string golden_dir = argv[3];
+    int num_frames = argc > 4 ? atoi(argv[4]) : 3000;
+
+    vector<string> titles;
+    for (int i = 5; i < argc; i++) titles.push_back(argv[i]);
+    if (titles.empty()) titles = supportedRomTitles();
+
+    int passed = 0, failed = 0, skipped = 0;
+    for (size_t r = 0; r < titles.size(); r++) {
+        string rom_file = rom_dir + "/" + titles[r] + ".bin";
+        string golden_file = golden_dir + "/" + titles[r] + ".golden";
+        if (!FilesystemNode::fileExists(rom_file)) {
+            cout << titles[r] << ": SKIPPED (no " << rom_file << ")" << endl;
+            skipped++;
+            continue;
+        }
+
+        vector<FrameHash> expected;
+        if (!record && !readGolden(golden_file, expected)) {
+            cout << titles[r] << ": SKIPPED (no golden trace " << golden_file << ")" << endl;
+            skipped++;
+            continue;
+        }
+
+        vector<FrameHash> actual;
+        bool ok = play(rom_file, record ? num_frames : (int)expected.size(), actual);
+
+        // A run whose round trips failed is not a reference for later ones
+        if (record) {
+            if (ok) writeGolden(golden_file, actual);
+        }
+        else {
+            for (size_t f = 0; f < expected.size() && f < actual.size(); f++) {
+                if (expected[f] != actual[f]) {
+                    cout << "  frame " << f << ": differs from the golden trace in"
+                         << describeDifference(expected[f], actual[f]) << endl;
+                    ok = false;
+                    break;
+                }
+            }
+            if (actual.size() != expected.size()) {
+                cout << "  the run stopped after " << actual.size() << " of "
+                     << expected.size() << " frames" << endl;
+                ok = false;
+            }
+        }
+
+        cout << titles[r] << ": " << (ok ? (record ? "RECORDED" : "OK") : "FAILED") << endl;
+        if (ok) passed++;
+        else failed++;
+    }
+
+    cout << passed << (record ? " recorded, " : " passed, ") << failed << " failed, "
+         << skipped << " skipped" << endl;
+    return failed > 0 ? 1 : 0;
+}
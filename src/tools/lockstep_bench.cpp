@@ -0,0 +1,107 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  lockstep_bench.cpp
+ *
+ *  Compares K independent environments with one ALELockstepBatch of K lanes
+ *  on the same action sequence. With probability 'shared' a step gives every
+ *  lane the same action, otherwise each lane draws its own; 1 is the best
+ *  case for the batch (e.g. evaluating a deterministic policy), 0 the worst.
+ *
+ *  Usage: lockstep_bench rom_file [lanes=32] [steps=5000] [shared=1]
+ *  Build with 'make -f makefile.unix lockstepbench'.
+ **************************************************************************** */
+
+#include <cstdio>
+#include <sys/time.h>
+
+#include "../ale_lockstep.hpp"
+
+static double now() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " rom_file [lanes] [steps] [shared]" << endl;
+        return -1;
+    }
+    string rom_file = argv[1];
+    int num_lanes = argc > 2 ? atoi(argv[2]) : 32;
+    int num_steps = argc > 3 ? atoi(argv[3]) : 5000;
+    double shared = argc > 4 ? atof(argv[4]) : 1.0;
+
+    ALEConfig config;
+    config.random_seed = 0;
+    config.max_num_frames = 0;
+    config.observation_mode = OBSERVE_RAM;
+
+    // Generate the action sequence once, so both runs see the same inputs
+    ActionVect minimal_actions;
+    {
+        ALEInterface probe;
+        if (!probe.loadROM(rom_file, config)) return -1;
+        minimal_actions = probe.allowed_actions;
+    }
+    srand(1);
+    vector<ActionVect> actions(num_steps, ActionVect(num_lanes));
+    for (int t = 0; t < num_steps; t++) {
+        bool same = rand() < shared * RAND_MAX;
+        for (int l = 0; l < num_lanes; l++) {
+            if (same && l > 0)
+                actions[t][l] = actions[t][0];
+            else
+                actions[t][l] = minimal_actions[rand() % minimal_actions.size()];
+        }
+    }
+
+    // K independent environments
+    vector<ALEInterface*> envs(num_lanes);
+    for (int l = 0; l < num_lanes; l++) {
+        envs[l] = new ALEInterface();
+        envs[l]->loadROM(rom_file, config);
+    }
+    double start = now();
+    for (int t = 0; t < num_steps; t++) {
+        for (int l = 0; l < num_lanes; l++) {
+            envs[l]->act(actions[t][l]);
+            if (envs[l]->game_over()) envs[l]->reset_game();
+        }
+    }
+    double independent = now() - start;
+    for (int l = 0; l < num_lanes; l++)
+        delete envs[l];
+
+    // One lockstep batch; like the environments above, a lane is reset on its
+    // own when its game ends
+    ALELockstepBatch batch;
+    if (!batch.loadROM(rom_file, num_lanes, config)) return -1;
+    vector<float> rewards;
+    long emulations = 0;
+    start = now();
+    for (int t = 0; t < num_steps; t++) {
+        batch.act(actions[t], rewards);
+        emulations += batch.num_groups;
+        for (int l = 0; l < num_lanes; l++) {
+            if (batch.lanes[l]->game_over())
+                batch.reset_lane(l);
+        }
+    }
+    double lockstep = now() - start;
+
+    double lane_steps = (double)num_lanes * num_steps;
+    printf("lanes %d, steps %d, shared %.2f\n", num_lanes, num_steps, shared);
+    printf("independent: %.0f lane-steps/sec\n", lane_steps / independent);
+    printf("lockstep:    %.0f lane-steps/sec (%.1f emulations per step)\n",
+           lane_steps / lockstep, (double)emulations / num_steps);
+    return 0;
+}
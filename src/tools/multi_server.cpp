@@ -0,0 +1,55 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  multi_server.cpp
+ *
+ *  Hosts num_envs environments of one ROM behind a local socket; see
+ *  src/ale_multi_server.hpp for the protocol. The address is a Unix socket
+ *  path, or tcp:PORT for a loopback TCP port.
+ *
+ *  Usage: multi_server rom_file [num_envs=64] [address=ale_multi.sock]
+ *                      [frame_skip=0] [random_seed=0]
+ *  Build with 'make -f makefile.unix multiserver'.
+ **************************************************************************** */
+
+#include <signal.h>
+
+#include "../ale_multi_server.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0]
+             << " rom_file [num_envs] [address] [frame_skip] [random_seed]" << endl;
+        return -1;
+    }
+    string rom_file = argv[1];
+    int num_envs = argc > 2 ? atoi(argv[2]) : 64;
+    string address = argc > 3 ? argv[3] : "ale_multi.sock";
+
+    ALEConfig config;
+    config.frame_skip = argc > 4 ? atoi(argv[4]) : 0;
+    config.random_seed = argc > 5 ? atoi(argv[5]) : 0;
+    // Episodes are ended by the game or by the client
+    config.max_num_frames = 0;
+    config.observation_mode = OBSERVE_NONE;
+
+    if (num_envs <= 0) {
+        cerr << "A.L.E: num_envs must be positive" << endl;
+        return -1;
+    }
+
+    // A client going away must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    ALEMultiServer server;
+    if (!server.loadROM(rom_file, num_envs, config)) return -1;
+    server.serve(address);
+    return 0;
+}
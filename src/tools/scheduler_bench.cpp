@@ -0,0 +1,68 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2012 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  scheduler_bench.cpp
+ *
+ *  Steps N environments with random actions on an ALEScheduler and reports
+ *  the throughput of every NUMA node. Running it with pin=0 shows what the
+ *  pinning and node-local placement are worth; running it with workers
+ *  limited to one socket's cores shows how far the batch scales across
+ *  sockets. Every environment gets an arena of arena_kb kilobytes
+ *  (ALEConfig::arena_size); 0 leaves its emulator objects on the heap.
+ *
+ *  Usage: scheduler_bench rom_file [envs=256] [steps=1000] [workers=0] [pin=1]
+ *                         [arena_kb=256]
+ *  Build with 'make -f makefile.unix schedulerbench'.
+ **************************************************************************** */
+
+#include <cstdio>
+
+#include "../ale_scheduler.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " rom_file [envs] [steps] [workers] [pin] [arena_kb]"
+             << endl;
+        return -1;
+    }
+    string rom_file = argv[1];
+    int num_envs = argc > 2 ? atoi(argv[2]) : 256;
+    int num_steps = argc > 3 ? atoi(argv[3]) : 1000;
+    int num_workers = argc > 4 ? atoi(argv[4]) : 0;
+    bool pin = argc > 5 ? atoi(argv[5]) != 0 : true;
+    int arena_kb = argc > 6 ? atoi(argv[6]) : 256;
+
+    ALEConfig config;
+    config.random_seed = 0;
+    config.max_num_frames = 0;
+    config.frame_skip = 4;
+    config.observation_mode = OBSERVE_RAM;
+    config.arena_size = arena_kb << 10;
+
+    ALEScheduler scheduler;
+    if (!scheduler.loadROM(rom_file, num_envs, config, num_workers, pin)) return -1;
+
+    ActionVect minimal_actions = scheduler.envs[0]->allowed_actions;
+    ActionVect actions(num_envs);
+    vector<float> rewards;
+    vector<uInt8> game_over;
+    srand(1);
+    scheduler.resetStats();
+    for (int t = 0; t < num_steps; t++) {
+        for (int e = 0; e < num_envs; e++)
+            actions[e] = minimal_actions[rand() % minimal_actions.size()];
+        scheduler.act(actions, rewards, game_over);
+    }
+
+    printf("envs %d, steps %d, %s, arena %d KB\n", num_envs, num_steps,
+           pin ? "pinned" : "not pinned", arena_kb);
+    scheduler.report(cout);
+    return 0;
+}